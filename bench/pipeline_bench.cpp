@@ -0,0 +1,738 @@
+// Micro benchmarks for the portable parts of the pipeline (no Winsock/GUI needed)
+// Build with "make bench" and run ./pipeline_bench
+#include "../src/FGDecoder.hpp"
+#include "../src/SensorData.hpp"
+#include "../src/DerivedMetrics.hpp"
+#include "../src/AlertManager.hpp"
+#include "../src/AlertRules.hpp"
+#include "../src/Logger.hpp"
+#include "../src/Pipeline.hpp"
+#include "../src/PackedSample.hpp"
+#include "../src/HistoryStore.hpp"
+#include "../src/AnomalyDetector.hpp"
+#include "../src/StreamHealth.hpp"
+#include "../src/Resampler.hpp"
+#include "../src/BlackBox.hpp"
+#include "../src/FlightSummary.hpp"
+#include "../src/Clock.hpp"
+#include <algorithm>
+#include <cmath>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+using BenchClock = std::chrono::steady_clock;
+
+// Random samples with the same ranges SensorReader::generateRandomData uses
+static std::vector<SensorData> makeSamples(std::size_t count) {
+    std::mt19937 gen(42);
+    auto r = [&](double lo, double hi) { return std::uniform_real_distribution<>(lo, hi)(gen); };
+
+    std::vector<SensorData> samples(count);
+    for (auto& d : samples) {
+        d = SensorData{ r(-20, 50), r(0, 15000), r(5, 6), r(30, 180), r(-1500, 1500),
+                        r(400, 2800), r(0, 100), r(15, 130), r(0, 300), r(0, 43), r(3, 25),
+                        r(-45, 45), r(-30, 30), r(-60, 60), r(-30, 30), r(-180, 180), r(-30, 30) };
+    }
+    return samples;
+}
+
+// Format a sample the way FlightGear does with sensor.xml
+static std::string encodeText(const SensorData& d) {
+    char buf[512];
+    int n = std::snprintf(buf, sizeof(buf),
+        "TF=%.6lf\tA=%.6lf\tAGL=%.6lf\tV=%.6lf\tVSF=%.6lf\tER=%.6lf\tT=%.6lf\tOP=%.6lf\tOT=%.6lf\t"
+        "FCG=%.6lf\tFFG=%.6lf\tPA=%.6lf\tPR=%.6lf\tRA=%.6lf\tRR=%.6lf\tYA=%.6lf\tYR=%.6lf\n",
+        d.temperature, d.altitude, d.agl, d.speed, d.verticalSpeed / 60, d.engineRPM, d.throttle,
+        d.oilPressure, d.oilTemperature, d.fuelCap, d.fuelFlow, d.pitch, d.pitchRate,
+        d.roll, d.rollRate, d.yaw, d.yawRate);
+    return std::string(buf, n);
+}
+
+static void putBE32(unsigned char* p, uint32_t v) {
+    p[0] = (unsigned char)(v >> 24); p[1] = (unsigned char)(v >> 16);
+    p[2] = (unsigned char)(v >> 8);  p[3] = (unsigned char)v;
+}
+
+// Format a sample the way FlightGear does with sensor_bin.xml
+static std::string encodeBinary(const SensorData& d) {
+    const double fields[FGDecoder::BINARY_FIELD_COUNT] = {
+        d.temperature, d.altitude, d.agl, d.speed, d.verticalSpeed / 60, d.engineRPM, d.throttle,
+        d.oilPressure, d.oilTemperature, d.fuelCap, d.fuelFlow, d.pitch, d.pitchRate,
+        d.roll, d.rollRate, d.yaw, d.yawRate };
+
+    std::string out(FGDecoder::BINARY_PACKET_SIZE, '\0');
+    unsigned char* p = reinterpret_cast<unsigned char*>(&out[0]);
+    for (std::size_t i = 0; i < FGDecoder::BINARY_FIELD_COUNT; ++i) {
+        float f = (float)fields[i];
+        uint32_t bits;
+        std::memcpy(&bits, &f, sizeof(bits));
+        putBE32(p + i * sizeof(float), bits);
+    }
+    putBE32(p + FGDecoder::BINARY_FIELD_COUNT * sizeof(float), FGDecoder::BINARY_MAGIC);
+    return out;
+}
+
+// Prevent the optimiser from dropping decode results
+static volatile double sink;
+
+static void benchDecode() {
+    const std::size_t N = 200000;
+    std::vector<SensorData> samples = makeSamples(1000);
+
+    std::vector<std::string> text, binary;
+    std::size_t textBytes = 0, binaryBytes = 0;
+    for (const auto& d : samples) {
+        text.push_back(encodeText(d));
+        binary.push_back(encodeBinary(d));
+        textBytes += text.back().size();
+        binaryBytes += binary.back().size();
+    }
+
+    SensorData out{};
+    auto t0 = BenchClock::now();
+    for (std::size_t i = 0; i < N; ++i) {
+        FGDecoder::parseText(text[i % text.size()], out);
+        sink = out.altitude;
+    }
+    auto t1 = BenchClock::now();
+    for (std::size_t i = 0; i < N; ++i) {
+        const std::string& pkt = binary[i % binary.size()];
+        FGDecoder::parseBinary(pkt.data(), pkt.size(), out);
+        sink = out.altitude;
+    }
+    auto t2 = BenchClock::now();
+
+    double textNs = std::chrono::duration<double, std::nano>(t1 - t0).count() / N;
+    double binNs = std::chrono::duration<double, std::nano>(t2 - t1).count() / N;
+
+    std::printf("[decode] text   : %6.1f bytes/sample %9.1f ns/sample\n",
+                (double)textBytes / samples.size(), textNs);
+    std::printf("[decode] binary : %6.1f bytes/sample %9.1f ns/sample\n",
+                (double)binaryBytes / samples.size(), binNs);
+    std::printf("[decode] binary is %.1fx smaller, %.1fx faster\n",
+                (double)textBytes / binaryBytes, textNs / binNs);
+}
+
+// Push samples through ingest -> evaluate -> CSV sink with different batch limits.
+// Channels are lossless so every sample is evaluated and written.
+static void benchBatching() {
+    const std::size_t N = 200000;
+    std::vector<SensorData> samples = makeSamples(1000);
+    const std::string dir = std::filesystem::temp_directory_path().string();
+
+    for (std::size_t maxBatch : {1, 8, 64, 256, 1024}) {
+        PipelineConfig config;
+        config.lossless = true;
+        config.maxBatch = maxBatch;
+
+        Logger logger(dir);
+        AlertHistory alertHistory;
+        logger.setAlertHistory(&alertHistory);
+        Pipeline pipeline(config);
+        pipeline.addTransform([&alertHistory](std::vector<PipelineSample>& batch) {
+            DerivedMetrics::compute(batch.data(), batch.size());
+            AlertManager::evaluate(batch.data(), batch.size());
+            alertHistory.process(batch.data(), batch.size());
+        });
+        pipeline.addSink(logger);
+        pipeline.start();
+
+        auto t0 = BenchClock::now();
+        for (std::size_t i = 0; i < N; ++i) {
+            PipelineSample sample;
+            sample.seq = i;
+            sample.time = i * 0.1;
+            sample.data = samples[i % samples.size()];
+            pipeline.input().push(sample);
+        }
+        pipeline.stop();
+        auto t1 = BenchClock::now();
+
+        double seconds = std::chrono::duration<double>(t1 - t0).count();
+        std::printf("[batch] max batch %5zu : %10.0f samples/s\n", maxBatch, N / seconds);
+    }
+    std::filesystem::remove(dir + "/sensor_log.csv");
+    std::filesystem::remove(dir + "/alert_events.csv");
+}
+
+// Size and cost of the compact sample, worst round trip error per channel, a check
+// that every int16 channel stays within its 0.005 rounding step and that the alert
+// mask comes back unchanged. Re-evaluating the rounded readings is only reported,
+// a value next to a threshold may land on the other side of it
+static bool benchPacking() {
+    const std::size_t N = 200000;
+    std::vector<SensorData> data = makeSamples(10000);
+    std::vector<PipelineSample> samples(data.size());
+    for (std::size_t i = 0; i < data.size(); ++i) {
+        samples[i].seq = i;
+        samples[i].time = i * 0.5;
+        samples[i].data = data[i];
+    }
+    DerivedMetrics::compute(samples.data(), samples.size());
+    AlertManager::evaluate(samples.data(), samples.size());
+
+    std::vector<PackedSample> packed(samples.size());
+    auto t0 = BenchClock::now();
+    for (std::size_t i = 0; i < N; ++i) {
+        packed[i % packed.size()] = packSample(samples[i % samples.size()]);
+    }
+    auto t1 = BenchClock::now();
+    for (std::size_t i = 0; i < N; ++i) {
+        sink = unpackSample(packed[i % packed.size()]).data.altitude;
+    }
+    auto t2 = BenchClock::now();
+
+    const std::size_t channels = sizeof(SensorData) / sizeof(double);
+    double maxError[channels] = {};
+    std::size_t changed = 0;
+    std::size_t reevaluated = 0;
+    for (std::size_t i = 0; i < samples.size(); ++i) {
+        PipelineSample back = unpackSample(packed[i]);
+        const double* a = reinterpret_cast<const double*>(&samples[i].data);
+        const double* b = reinterpret_cast<const double*>(&back.data);
+        for (std::size_t c = 0; c < channels; ++c) {
+            maxError[c] = std::max(maxError[c], std::fabs(a[c] - b[c]));
+        }
+        if (toAlertMask(back.alerts) != toAlertMask(samples[i].alerts)) ++changed;
+        if (toAlertMask(AlertManager::evaluate(back.data)) != toAlertMask(samples[i].alerts)) ++reevaluated;
+    }
+
+    std::printf("[pack] SensorData %zu -> %zu bytes, sample %zu -> %zu bytes (%.1fx)\n",
+                sizeof(SensorData), sizeof(PackedSensorData),
+                sizeof(PipelineSample), sizeof(PackedSample),
+                (double)sizeof(PipelineSample) / sizeof(PackedSample));
+    std::printf("[pack] pack %.1f ns/sample, unpack %.1f ns/sample\n",
+                std::chrono::duration<double, std::nano>(t1 - t0).count() / N,
+                std::chrono::duration<double, std::nano>(t2 - t1).count() / N);
+    std::printf("[pack] max abs error per channel:");
+    for (std::size_t c = 0; c < channels; ++c) std::printf(" %.4g", maxError[c]);
+
+    // Channels stored as float are exact to well below this, so one bound covers all
+    bool resolutionOk = true;
+    for (std::size_t c = 0; c < channels; ++c) {
+        if (maxError[c] > 0.005 + 1e-9) resolutionOk = false;
+    }
+    std::printf("\n[pack] every channel within 0.005 of the original: %s\n", resolutionOk ? "ok" : "FAIL");
+    std::printf("[pack] alert masks changed by packing: %zu of %zu (%s)\n",
+                changed, samples.size(), changed == 0 ? "ok" : "FAIL");
+    std::printf("[pack] readings that evaluate differently once rounded: %zu of %zu (the mask is kept)\n",
+                reevaluated, samples.size());
+    return resolutionOk && changed == 0;
+}
+
+// Feed a 10 hour flight at 10 Hz into the history store, then time one plot query
+// (350 px wide, the GUI's plot width) for spans from 10 s to the whole flight
+static void benchHistory() {
+    const double rate = 10.0;
+    const std::size_t N = (std::size_t)(10 * 3600 * rate);
+    std::vector<SensorData> samples = makeSamples(1000);
+    HistoryStore history;
+
+    auto t0 = BenchClock::now();
+    for (std::size_t i = 0; i < N; ++i) {
+        history.add(samples[i % samples.size()], i / rate);
+    }
+    auto t1 = BenchClock::now();
+    std::printf("[history] add %.1f ns/sample, %zu samples\n",
+                std::chrono::duration<double, std::nano>(t1 - t0).count() / N, N);
+
+    std::vector<HistoryPoint> points;
+    const double end = history.latestTime();
+    for (double span : {10.0, 60.0, 600.0, 3600.0, 36000.0}) {
+        const int Q = 2000;
+        int tier = 0;
+        auto q0 = BenchClock::now();
+        for (int q = 0; q < Q; ++q) {
+            tier = history.query(CH_ALTITUDE, end - span, end, 350, points);
+        }
+        auto q1 = BenchClock::now();
+        std::printf("[history] span %6.0f s : tier %d, %5zu points, %8.1f us/query\n",
+                    span, tier, points.size(),
+                    std::chrono::duration<double, std::micro>(q1 - q0).count() / Q);
+    }
+}
+
+// Per sample cost of the anomaly detector, how often it flags uniform random data
+// (false alarms), and how many samples it takes to flag an oil temperature creep of
+// 0.02 F per sample that stays well inside the 245 F limit. Fails if the noisy cruise
+// before the creep raises drift for any of the seeds
+static bool benchAnomaly() {
+    const std::size_t N = 1000000;
+    std::vector<SensorData> samples = makeSamples(10000);
+
+    AnomalyDetector detector;
+    std::size_t flagged = 0;
+    auto t0 = BenchClock::now();
+    for (std::size_t i = 0; i < N; ++i) {
+        if (detector.process(samples[i % samples.size()]).any()) ++flagged;
+    }
+    auto t1 = BenchClock::now();
+    uint32_t alerts = 0;
+    for (std::size_t i = 0; i < N; ++i) {
+        alerts |= toAlertMask(AlertManager::evaluate(samples[i % samples.size()]));
+    }
+    auto t2 = BenchClock::now();
+    sink = alerts;
+    std::printf("[anomaly] %.1f ns/sample (17 channels), thresholds alone %.1f ns/sample\n",
+                std::chrono::duration<double, std::nano>(t1 - t0).count() / N,
+                std::chrono::duration<double, std::nano>(t2 - t1).count() / N);
+    std::printf("[anomaly] random data flagged on %.3f%% of samples\n", 100.0 * flagged / N);
+
+    // Steady cruise with noise, then the creep starts at sample 1000
+    bool ok = true;
+    for (unsigned seed : {7u, 8u, 9u}) {
+        std::mt19937 gen(seed);
+        std::normal_distribution<> noise(0.0, 1.0);
+        AnomalyDetector creep;
+        SensorData d = samples[0];
+        long detectedAt = -1;
+        std::size_t falseDrift = 0;
+        for (int i = 0; i < 5000 && detectedAt < 0; ++i) {
+            d.oilTemperature = 180.0 + noise(gen) + (i > 1000 ? (i - 1000) * 0.02 : 0.0);
+            AnomalyFlags f = creep.process(d);
+            if (i <= 1000 && f.drift) ++falseDrift;
+            if (i > 1000 && (f.drift & (1u << CH_OIL_TEMPERATURE))) detectedAt = i - 1000;
+        }
+        ok = ok && falseDrift == 0 && detectedAt >= 0;
+        std::printf("[anomaly] seed %u: %zu drift flags before the creep (%s), 0.02 F/sample creep flagged after %ld samples (%.1f F above cruise)\n",
+                    seed, falseDrift, falseDrift == 0 ? "ok" : "FAIL", detectedAt, detectedAt * 0.02);
+    }
+    return ok;
+}
+
+// Stream health accounting cost per datagram, and a check of the loss/reorder/duplicate
+// counts on a simulated 60 Hz stream: every 100th packet dropped, every 250th swapped
+// with its successor, every 400th sent twice. Once numbered (SEQ=), once with only the
+// sender clock (ST=).
+static void benchStreamHealth() {
+    const uint64_t N = 1000000;
+    for (bool numbered : {true, false}) {
+        StreamMonitor monitor;
+        SourceHealth& health = monitor.source(0x0100007f, 0x7c15); // 127.0.0.1:5500
+        uint64_t dropped = 0, swapped = 0, doubled = 0;
+
+        auto send = [&](uint64_t seq) {
+            StreamStamp stamp;
+            stamp.hasSeq = numbered;
+            stamp.seq = seq;
+            stamp.hasTime = true;
+            stamp.simTime = seq / 60.0;
+            health.onPacket(stamp, seq / 60.0 + (seq % 7) * 0.0005);
+        };
+
+        auto t0 = BenchClock::now();
+        for (uint64_t seq = 1; seq <= N; ++seq) {
+            if (seq % 100 == 0) { ++dropped; continue; }
+            if (seq % 250 == 1 && seq + 1 <= N && (seq + 1) % 100 != 0) {
+                send(seq + 1);
+                send(seq);
+                ++seq;
+                ++swapped;
+                continue;
+            }
+            send(seq);
+            if (seq % 400 == 3) { send(seq); ++doubled; }
+        }
+        auto t1 = BenchClock::now();
+
+        StreamHealthStats st = health.snapshot(N / 60.0);
+        std::printf("[stream] %s: %.1f ns/datagram, lost %llu/%llu reordered %llu/%llu duplicated %llu/%llu, jitter %.2f ms\n",
+                    numbered ? "SEQ" : "ST ",
+                    std::chrono::duration<double, std::nano>(t1 - t0).count() / N,
+                    (unsigned long long)st.lost, (unsigned long long)dropped,
+                    (unsigned long long)st.reordered, (unsigned long long)swapped,
+                    (unsigned long long)st.duplicated, (unsigned long long)doubled, st.jitterMs);
+    }
+}
+
+// Compiled alert rules against the hand-written AlertManager::evaluate
+static void benchRules() {
+    const char* path = "src/alert_rules.txt";
+    AlertRules rules;
+    if (!rules.load(path)) {
+        std::printf("[rules] skipped, run from the repository root\n");
+        return;
+    }
+
+    // A quarter of the samples on the ground so the agl guard is exercised
+    const std::size_t N = 1000000;
+    std::vector<SensorData> samples = makeSamples(10000);
+    for (std::size_t i = 0; i < samples.size(); i += 4) samples[i].agl = 2.0;
+    std::vector<DerivedData> derived(samples.size());
+    for (std::size_t i = 0; i < samples.size(); ++i) derived[i] = DerivedMetrics::compute(samples[i]);
+
+    std::size_t mismatched = 0;
+    uint32_t custom = 0;
+    for (std::size_t i = 0; i < samples.size(); ++i) {
+        if (rules.evaluate(samples[i], derived[i], i * 0.1, custom) !=
+            toAlertMask(AlertManager::evaluate(samples[i], derived[i]))) ++mismatched;
+    }
+
+    uint32_t alerts = 0;
+    auto t0 = BenchClock::now();
+    for (std::size_t i = 0; i < N; ++i) {
+        alerts |= toAlertMask(AlertManager::evaluate(samples[i % samples.size()], derived[i % samples.size()]));
+    }
+    auto t1 = BenchClock::now();
+    for (std::size_t i = 0; i < N; ++i) {
+        alerts |= rules.evaluate(samples[i % samples.size()], derived[i % samples.size()], i * 0.1, custom);
+    }
+    auto t2 = BenchClock::now();
+    std::vector<PipelineSample> batch(256);
+    std::size_t done = 0;
+    while (done < N) {
+        for (std::size_t i = 0; i < batch.size(); ++i) {
+            batch[i].data = samples[(done + i) % samples.size()];
+            batch[i].derived = derived[(done + i) % samples.size()];
+            batch[i].time = (done + i) * 0.1;
+        }
+        rules.evaluate(batch.data(), batch.size());
+        alerts |= toAlertMask(batch.back().alerts);
+        done += batch.size();
+    }
+    auto t3 = BenchClock::now();
+    sink = alerts;
+
+    std::printf("[rules] %zu rules compiled to %zu instructions\n", rules.ruleCount(), rules.getInstructionCount());
+    std::printf("[rules] hand-written %.1f ns/sample, rules %.1f ns/sample, rules batch of 256 %.1f ns/sample (incl. copy)\n",
+                std::chrono::duration<double, std::nano>(t1 - t0).count() / N,
+                std::chrono::duration<double, std::nano>(t2 - t1).count() / N,
+                std::chrono::duration<double, std::nano>(t3 - t2).count() / done);
+    std::printf("[rules] built-in alert masks differing from AlertManager: %zu of %zu\n", mismatched, samples.size());
+
+    // "for 2s": pitch rate over the limit at 10 Hz only raises after 2 seconds
+    AlertRules hold;
+    std::string error;
+    hold.compile("SUSTAINED: agl > 5 && abs(pitchRate) > 15 for 2s", error);
+    SensorData d = samples[1];
+    d.agl = 100.0;
+    d.pitchRate = 20.0;
+    double raisedAfter = -1.0;
+    for (int i = 0; i < 50 && raisedAfter < 0.0; ++i) {
+        hold.evaluate(d, DerivedMetrics::compute(d), i * 0.1, custom);
+        if (custom & 1u) raisedAfter = i * 0.1;
+    }
+    std::printf("[rules] 'for 2s' rule raised after %.1f s of pitch rate over the limit\n", raisedAfter);
+}
+
+// Jittered ~10 Hz input with a dropout, resampled onto a 20 Hz grid
+static void benchResample() {
+    const std::size_t N = 1000000;
+    std::mt19937 gen(11);
+    std::uniform_real_distribution<> jitter(0.05, 0.15);
+
+    // Altitude is a straight line in time so linear interpolation should be exact
+    std::vector<PipelineSample> input(N);
+    double t = 0.0;
+    for (std::size_t i = 0; i < N; ++i) {
+        t += (i == N / 2) ? 3.0 : jitter(gen); // One 3 s dropout
+        input[i].seq = i;
+        input[i].time = t;
+        input[i].data.altitude = 1000.0 + 10.0 * t;
+        input[i].data.throttle = (double)(i / 100);
+        input[i].data.yaw = std::fmod(t * 7.0, 360.0) - 180.0;
+    }
+
+    Resampler resampler(20.0, 1.0);
+    resampler.setMode(CH_THROTTLE, ResampleMode::Hold);
+    std::vector<PipelineSample> batch;
+    double worstSpacing = 0.0, worstError = 0.0, lastTime = -1.0;
+    std::size_t heldWrong = 0, outputs = 0;
+    auto t0 = BenchClock::now();
+    for (std::size_t i = 0; i < N; i += 256) {
+        batch.assign(input.begin() + i, input.begin() + std::min(N, i + 256));
+        resampler.process(batch);
+        for (const PipelineSample& s : batch) {
+            if (lastTime >= 0.0) worstSpacing = std::max(worstSpacing, std::fabs(s.time - lastTime - 0.05));
+            lastTime = s.time;
+            if (!s.gap) worstError = std::max(worstError, std::fabs(s.data.altitude - (1000.0 + 10.0 * s.time)));
+            if (s.data.throttle != std::floor(s.data.throttle)) ++heldWrong;
+        }
+        outputs += batch.size();
+    }
+    auto t1 = BenchClock::now();
+    sink = lastTime;
+    std::printf("[resample] %.1f ns/input sample, %zu in -> %zu out at 20 Hz\n",
+                std::chrono::duration<double, std::nano>(t1 - t0).count() / N, N, outputs);
+    std::printf("[resample] worst grid spacing error %.2e s, worst linear error %.2e ft, held channel non-step values %zu\n",
+                worstSpacing, worstError, heldWrong);
+    std::printf("[resample] %llu points marked as gap (3 s dropout at 20 Hz = 60 expected)\n",
+                (unsigned long long)resampler.getGapCount());
+}
+
+// 100 Hz stream with low oil pressure raised for 1 s every minute, 30 s before / 10 s after
+static void benchBlackBox() {
+    const std::filesystem::path dir = std::filesystem::temp_directory_path() / "pipeline_bench_blackbox";
+    std::filesystem::remove_all(dir);
+
+    const std::size_t N = 200000; // 2000 s
+    std::vector<SensorData> samples = makeSamples(10000);
+    std::vector<PipelineSample> batch(100);
+    double consumeNs = 0.0;
+    {
+        BlackBox blackBox(1u << 9, 30.0, 10.0, 100, dir.string()); // LOW OIL PRESSURE
+        for (std::size_t i = 0; i < N; i += batch.size()) {
+            for (std::size_t j = 0; j < batch.size(); ++j) {
+                PipelineSample& s = batch[j];
+                s.seq = i + j;
+                s.time = (i + j) * 0.01;
+                s.data = samples[(i + j) % samples.size()];
+                s.alerts = AlertFlags{};
+                s.alerts.lowOilPressure = std::fmod(s.time, 60.0) >= 45.0 && std::fmod(s.time, 60.0) < 46.0;
+            }
+            auto t0 = BenchClock::now();
+            blackBox.consumeBatch(batch);
+            consumeNs += std::chrono::duration<double, std::nano>(BenchClock::now() - t0).count();
+
+            // Give the writer a moment per simulated minute, a real 100 Hz feed gives it 60 s
+            if ((i / batch.size()) % 60 == 59) std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        }
+    } // Destructor waits for the writer and prints written/skipped
+
+    // Check one capture: 3000 rows before the trigger, 1000 after
+    std::size_t rows = 0, files = 0;
+    for (const auto& entry : std::filesystem::directory_iterator(dir)) {
+        if (files++ == 1) {
+            std::ifstream file(entry.path());
+            std::string line;
+            while (std::getline(file, line)) ++rows;
+            rows -= 2; // Comment and header
+        }
+    }
+    std::filesystem::remove_all(dir);
+
+    std::printf("[blackbox] %.1f ns/sample on the sink thread, %zu event files for 33 rises\n", consumeNs / N, files);
+    std::printf("[blackbox] second capture has %zu rows (30 s before + 10 s after at 100 Hz, 4000 +-1 expected)\n", rows);
+}
+
+// Summary cost per sample and a check of its totals on a known 10 hour flight
+static void benchSummary() {
+    // 10 Hz, 10 h: climb to 14000 ft over the first hour, cruise, constant 10 gph
+    const std::size_t N = 360000;
+    std::vector<PipelineSample> flight(N);
+    for (std::size_t i = 0; i < N; ++i) {
+        PipelineSample& s = flight[i];
+        s.time = i * 0.1;
+        s.data = SensorData{};
+        s.data.agl = 1000.0;
+        s.data.altitude = std::min(14000.0, s.time * 14000.0 / 3600.0);
+        s.data.fuelFlow = 10.0;
+        s.data.fuelCap = 53.0 - s.time * 10.0 / 3600.0;
+        s.data.pitchRate = (i == N / 2) ? -22.5 : 1.0;
+        s.alerts = AlertManager::evaluate(s.data);
+    }
+
+    AlertHistory alerts;
+    FlightSummary summary(alerts);
+    auto t0 = BenchClock::now();
+    for (std::size_t i = 0; i < N; i += 256) {
+        const std::size_t n = std::min<std::size_t>(256, N - i);
+        alerts.process(flight.data() + i, n);
+        summary.process(flight.data() + i, n);
+    }
+    auto t1 = BenchClock::now();
+    FlightSummaryStats st = summary.snapshot();
+    const AlertStats ceiling = alerts.getStats()[2];
+
+    // Above 13500 ft from t = 3471.4 s to the end
+    const double ceilingExpected = (N - 1) * 0.1 - 13500.0 * 3600.0 / 14000.0;
+    std::printf("[summary] %.1f ns/sample with alert history (batches of 256), report ready at shutdown regardless of length\n",
+                std::chrono::duration<double, std::nano>(t1 - t0).count() / N);
+    std::printf("[summary] 10 h flight: max alt %.0f ft, above ceiling %.1f s (expected %.1f +-0.1), fuel burned %.2f gal (expected %.2f)\n",
+                st.maxAltitude, st.timeAboveCeiling, ceilingExpected, st.fuelBurned, (N - 1) * 0.1 * 10.0 / 3600.0);
+    std::printf("[summary] ceiling alert raised %u time(s), active %.1f s, peak pitch rate %.1f deg/s\n",
+                ceiling.count, ceiling.totalDuration, st.peakPitchRate);
+}
+
+// Decode -> evaluate -> CSV with the threaded graph (ingest, analyze and csv threads
+// handing off through channels) against --reactor's inline Pipeline::runInline on one
+// thread. Binary datagrams are pre-encoded, so the socket itself is not part of this.
+static void benchReactor() {
+    const std::size_t N = 200000;
+    std::vector<std::string> datagrams;
+    for (const SensorData& d : makeSamples(1000)) datagrams.push_back(encodeBinary(d));
+    const std::string dir = std::filesystem::temp_directory_path().string();
+
+    PipelineConfig config;
+    config.lossless = true;
+    config.maxBatch = 64;
+    for (std::size_t burst : {1, 16, 64}) { // Datagrams pending per wake-up
+        double threaded = 0.0, inlined = 0.0;
+        double threadedCpu = 0.0, inlinedCpu = 0.0;
+        for (int mode = 0; mode < 2; ++mode) {
+            Logger logger(dir);
+            AlertHistory alertHistory;
+            logger.setAlertHistory(&alertHistory);
+            Pipeline pipeline(config);
+            pipeline.addTransform([&alertHistory](std::vector<PipelineSample>& batch) {
+                DerivedMetrics::compute(batch.data(), batch.size());
+                AlertManager::evaluate(batch.data(), batch.size());
+                alertHistory.process(batch.data(), batch.size());
+            });
+            pipeline.addSink(logger);
+            if (mode == 0) pipeline.start();
+            else pipeline.beginInline();
+
+            std::vector<PipelineSample> batch;
+            batch.reserve(burst);
+            const std::clock_t c0 = std::clock();
+            auto t0 = BenchClock::now();
+            for (std::size_t i = 0; i < N; i += burst) {
+                batch.clear();
+                for (std::size_t j = i; j < i + burst && j < N; ++j) {
+                    PipelineSample sample;
+                    sample.seq = j;
+                    sample.time = j * 0.01;
+                    const std::string& pkt = datagrams[j % datagrams.size()];
+                    FGDecoder::parseBinary(pkt.data(), pkt.size(), sample.data);
+                    if (mode == 0) pipeline.input().push(sample);
+                    else batch.push_back(sample);
+                }
+                if (mode == 1) pipeline.runInline(batch);
+            }
+            if (mode == 0) pipeline.stop();
+            else pipeline.endInline();
+            auto t1 = BenchClock::now();
+            (mode == 0 ? threaded : inlined) = N / std::chrono::duration<double>(t1 - t0).count();
+            (mode == 0 ? threadedCpu : inlinedCpu) = 1e9 * (std::clock() - c0) / CLOCKS_PER_SEC / N;
+        }
+        std::printf("[reactor] bursts of %2zu: threaded %7.0f samples/s %6.0f ns CPU/sample, inline %7.0f samples/s %6.0f ns CPU/sample\n",
+                    burst, threaded, threadedCpu, inlined, inlinedCpu);
+    }
+    std::filesystem::remove(dir + "/sensor_log.csv");
+    std::filesystem::remove(dir + "/alert_events.csv");
+}
+
+// Cost of the derived-metrics stage and its values on hand-checked cases
+static void benchDerived() {
+    const std::size_t N = 1000000;
+    std::vector<SensorData> data = makeSamples(10000);
+    std::vector<PipelineSample> batch(256);
+    std::size_t done = 0;
+    double checksum = 0.0;
+    auto t0 = BenchClock::now();
+    while (done < N) {
+        for (std::size_t i = 0; i < batch.size(); ++i) batch[i].data = data[(done + i) % data.size()];
+        DerivedMetrics::compute(batch.data(), batch.size());
+        checksum += batch.back().derived.loadFactor;
+        done += batch.size();
+    }
+    auto t1 = BenchClock::now();
+    sink = (uint32_t)checksum;
+
+    // Standard day at 5000 ft, 30 gal at 10 gph and 100 kt, 500 ft/min, 60 degrees of roll
+    SensorData d{};
+    d.altitude = 5000.0;
+    d.temperature = (15.0 - 0.00198 * 5000.0) * 9.0 / 5.0 + 32.0;
+    d.fuelCap = 30.0;
+    d.fuelFlow = 10.0;
+    d.speed = 100.0;
+    d.verticalSpeed = 500.0;
+    d.roll = 60.0;
+    const DerivedData k = DerivedMetrics::compute(d);
+
+    std::printf("[derived] batch of 256 %.1f ns/sample (incl. copy)\n",
+                std::chrono::duration<double, std::nano>(t1 - t0).count() / done);
+    std::printf("[derived] ISA 5000 ft: density altitude %.1f ft (5000), endurance %.1f min (180), range %.1f nm (300),"
+                " climb %.2f %% (4.94), 60 deg roll %.3f g (2.000)\n",
+                k.densityAltitude, k.endurance, k.range, k.climbGradient, k.loadFactor);
+}
+
+// One simulated flight through derive -> evaluate -> CSV, paced and stamped by clock
+static void runClockedFlight(Clock& clock, double duration, const std::string& dir) {
+    PipelineConfig config;
+    config.lossless = true;
+    Logger logger(dir);
+    logger.setClock(&clock);
+    AlertHistory alertHistory;
+    logger.setAlertHistory(&alertHistory);
+    Pipeline pipeline(config);
+    pipeline.addTransform([&alertHistory](std::vector<PipelineSample>& batch) {
+        DerivedMetrics::compute(batch.data(), batch.size());
+        AlertManager::evaluate(batch.data(), batch.size());
+        alertHistory.process(batch.data(), batch.size());
+    });
+    pipeline.addSink(logger);
+    pipeline.start();
+
+    std::mt19937 gen(42);
+    std::uniform_real_distribution<> unit(0.0, 1.0);
+    std::vector<SensorData> data = makeSamples(1000);
+    for (uint64_t seq = 0; clock.now() < duration; ++seq) {
+        PipelineSample sample;
+        sample.seq = seq;
+        sample.time = clock.now();
+        sample.data = data[seq % data.size()];
+        sample.data.fuelCap *= unit(gen);
+        pipeline.input().push(sample);
+        clock.sleepUntil(clock.now() + 0.1);
+    }
+    pipeline.stop();
+}
+
+// Reads a whole file for comparison
+static std::string readFile(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    return std::string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+}
+
+// A 10 hour 10 Hz flight on the virtual clock, twice, must log the same bytes, and
+// the scaled clock must sleep 1/scale of the clock time
+static void benchClock() {
+    const std::string dir = std::filesystem::temp_directory_path().string();
+    const std::string first = dir + "/clock_a", second = dir + "/clock_b";
+    std::filesystem::create_directories(first);
+    std::filesystem::create_directories(second);
+
+    auto t0 = BenchClock::now();
+    VirtualClock clockA;
+    runClockedFlight(clockA, 36000.0, first);
+    auto t1 = BenchClock::now();
+    VirtualClock clockB;
+    runClockedFlight(clockB, 36000.0, second);
+
+    bool identical = true;
+    for (const char* name : {"/sensor_log.csv", "/alert_events.csv"}) {
+        identical = identical && readFile(first + name) == readFile(second + name);
+    }
+    const std::size_t bytes = readFile(first + "/sensor_log.csv").size();
+
+    ScaledClock scaled(20.0);
+    auto t2 = BenchClock::now();
+    scaled.sleepUntil(2.0);
+    auto t3 = BenchClock::now();
+
+    std::printf("[clock] 10 h virtual flight at 10 Hz: %.2f s wall, %zu KB of CSV, second run identical: %s\n",
+                std::chrono::duration<double>(t1 - t0).count(), bytes / 1024, identical ? "yes" : "NO");
+    std::printf("[clock] scaled x20: 2 s of clock time slept %.0f ms (100)\n",
+                std::chrono::duration<double, std::milli>(t3 - t2).count());
+    std::filesystem::remove_all(first);
+    std::filesystem::remove_all(second);
+}
+
+int main() {
+    benchDecode();
+    benchBatching();
+    const bool packingOk = benchPacking();
+    benchHistory();
+    const bool anomalyOk = benchAnomaly();
+    benchStreamHealth();
+    benchRules();
+    benchResample();
+    benchBlackBox();
+    benchSummary();
+    benchReactor();
+    benchDerived();
+    benchClock();
+    return packingOk && anomalyOk ? 0 : 1;
+}
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <cstdint>
+
 //Struct for alert flags
 struct AlertFlags{
     // Temperature
@@ -27,6 +29,7 @@ struct AlertFlags{
     bool lowFuel = false;
     bool lowFuelFlow = false;
     bool highFuelFlow = false;
+    bool lowEndurance = false;
 
     // Orientation
     bool pitchExceeded = false;
@@ -35,3 +38,51 @@ struct AlertFlags{
     bool rollRateExceeded = false;
     bool yawRateExceeded = false;
 };
+
+// Number of alerts in AlertFlags
+static constexpr int ALERT_COUNT = 20;
+
+// Log names for each alert, index is the alert's bit in toAlertMask
+inline const char* const ALERT_NAMES[ALERT_COUNT] = {
+    "BELOW OP TEMP", "ABOVE OP TEMP", "ABOVE ALT CEILING",
+    "STALL SPEED", "OVER MAXSPEED", "OVER SAFE VERTSPEED",
+    "LOW ENGINE RPM", "HIGH ENGINE RPM",
+    "HIGH OIL TEMP", "LOW OIL PRESSURE", "HIGH OIL PRESSURE",
+    "LOW FUEL", "LOW FUEL FLOW", "HIGH FUEL FLOW",
+    "PITCH", "PITCH RATE", "ROLL", "ROLL RATE", "YAW RATE",
+    "LOW ENDURANCE"
+};
+
+// Pack flags into a bitmask so consecutive samples can be compared with XOR
+inline uint32_t toAlertMask(const AlertFlags& f){
+    const bool bits[ALERT_COUNT] = {
+        f.belowOperatingTemp, f.aboveOperatingTemp, f.aboveAltitudeCeiling,
+        f.stallSpeed, f.overMaxSpeed, f.overSafeVerticalSpeed,
+        f.lowEngineRPM, f.highEngineRPM,
+        f.highOilTemp, f.lowOilPressure, f.highOilPressure,
+        f.lowFuel, f.lowFuelFlow, f.highFuelFlow,
+        f.pitchExceeded, f.pitchRateExceeded, f.rollExceeded, f.rollRateExceeded, f.yawRateExceeded,
+        f.lowEndurance
+    };
+    uint32_t mask = 0;
+    for (int i = 0; i < ALERT_COUNT; ++i)
+        if (bits[i]) mask |= (1u << i);
+    return mask;
+}
+
+// Inverse of toAlertMask
+inline AlertFlags fromAlertMask(uint32_t mask){
+    AlertFlags f{};
+    bool* order[ALERT_COUNT] = {
+        &f.belowOperatingTemp, &f.aboveOperatingTemp, &f.aboveAltitudeCeiling,
+        &f.stallSpeed, &f.overMaxSpeed, &f.overSafeVerticalSpeed,
+        &f.lowEngineRPM, &f.highEngineRPM,
+        &f.highOilTemp, &f.lowOilPressure, &f.highOilPressure,
+        &f.lowFuel, &f.lowFuelFlow, &f.highFuelFlow,
+        &f.pitchExceeded, &f.pitchRateExceeded, &f.rollExceeded, &f.rollRateExceeded, &f.yawRateExceeded,
+        &f.lowEndurance
+    };
+    for (int i = 0; i < ALERT_COUNT; ++i)
+        *order[i] = (mask >> i) & 1u;
+    return f;
+}
@@ -0,0 +1,71 @@
+#include "AlertHistory.hpp"
+#include <algorithm>
+
+/*-------------------------------------------------------------------------------------
+// Title: AlertHistory::update
+// Description:
+// Compare the alerts of the latest sample with the previous sample. Every bit that
+// flipped produces a raise or clear event with its timestamp, and the per-alert
+// count, total active time and longest episode are updated incrementally.
+-------------------------------------------------------------------------------------*/
+void AlertHistory::update(uint32_t mask, double time) {
+    lastTime = time;
+
+    uint32_t changed = mask ^ previousMask;
+    previousMask = mask;
+
+    // Visit only the bits that flipped
+    while (changed) {
+        int i = __builtin_ctz(changed);
+        changed &= changed - 1;
+
+        AlertStats& s = stats[i];
+        AlertEvent event{time, i, ((mask >> i) & 1u) != 0, 0.0};
+
+        if (event.raised) {
+            ++s.count;
+            s.active = true;
+            s.activeSince = time;
+        } else {
+            event.duration = time - s.activeSince;
+            s.totalDuration += event.duration;
+            s.longest = std::max(s.longest, event.duration);
+            s.active = false;
+        }
+
+        unlogged.push_back(event);
+        recent.push_back(event);
+        if (recent.size() > RECENT_EVENTS) recent.pop_front();
+    }
+}// End of update
+
+// One lock per batch
+void AlertHistory::process(const PipelineSample* samples, std::size_t count) {
+    std::lock_guard<std::mutex> lock(historyMutex);
+    for (std::size_t i = 0; i < count; ++i) update(toAlertMask(samples[i].alerts), samples[i].time);
+}
+
+void AlertHistory::takeEvents(std::vector<AlertEvent>& events) {
+    std::lock_guard<std::mutex> lock(historyMutex);
+    events.insert(events.end(), unlogged.begin(), unlogged.end());
+    unlogged.clear();
+}
+
+// Copy of the stats with open episodes counted up to the latest sample
+std::array<AlertStats, ALERT_COUNT> AlertHistory::getStats() {
+    std::lock_guard<std::mutex> lock(historyMutex);
+    std::array<AlertStats, ALERT_COUNT> copy = stats;
+    for (auto& s : copy) {
+        if (s.active) {
+            double open = lastTime - s.activeSince;
+            s.totalDuration += open;
+            s.longest = std::max(s.longest, open);
+        }
+    }
+    return copy;
+}
+
+std::deque<AlertEvent> AlertHistory::getRecentEvents() {
+    std::lock_guard<std::mutex> lock(historyMutex);
+    return recent;
+}
@@ -0,0 +1,58 @@
+#pragma once
+
+#include "AlertFlags.hpp"
+#include "PipelineSample.hpp"
+#include <array>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <vector>
+
+// A single alert transition
+struct AlertEvent {
+    double time;      // Seconds since the pipeline started
+    int alert;        // Index into ALERT_NAMES
+    bool raised;      // true = alert became active, false = alert cleared
+    double duration;  // Length of the episode that just ended (clear events only)
+};
+
+// Running totals for one alert
+struct AlertStats {
+    uint32_t count = 0;         // Number of times the alert was raised
+    double totalDuration = 0.0; // Seconds spent active, including a still open episode
+    double longest = 0.0;       // Longest single episode in seconds
+    bool active = false;        // Currently raised
+    double activeSince = 0.0;   // Start of the open episode
+};
+
+// Turns the per-sample alert state into raise/clear events. Runs in the analyze stage,
+// the one record of alert counts and durations the flight summary, the CSV event log
+// and the GUI all read from.
+// Each update XORs the new mask with the previous one so only changed bits are visited,
+// a sample where nothing changed costs one compare.
+class AlertHistory {
+public:
+    static constexpr std::size_t RECENT_EVENTS = 100; // Events kept for the GUI
+
+    // Analyze stage: feed a batch of evaluated samples. New events are also kept for
+    // takeEvents until the CSV sink collects them
+    void process(const PipelineSample* samples, std::size_t count);
+
+    // Move the events produced since the last call to the end of events
+    void takeEvents(std::vector<AlertEvent>& events);
+
+    // Thread-safe copies for display and the flight summary
+    std::array<AlertStats, ALERT_COUNT> getStats();
+    std::deque<AlertEvent> getRecentEvents();
+
+private:
+    std::mutex historyMutex;
+    uint32_t previousMask = 0;
+    double lastTime = 0.0;
+    std::array<AlertStats, ALERT_COUNT> stats{};
+    std::deque<AlertEvent> recent;
+    std::vector<AlertEvent> unlogged; // Waiting for takeEvents
+
+    // Alerts of the next sample, historyMutex held
+    void update(uint32_t mask, double time);
+};
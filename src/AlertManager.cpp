@@ -1,9 +1,14 @@
 #include "AlertManager.hpp"
+#include "DerivedMetrics.hpp"
 #include "cmath"
 
 // Method check data against threshold limit of the Cesna
 // and raise flags on bad checks
 AlertFlags AlertManager::evaluate(const SensorData& data){
+    return evaluate(data, DerivedMetrics::compute(data));
+}
+
+AlertFlags AlertManager::evaluate(const SensorData& data, const DerivedData& derived){
     AlertFlags flags{};
     using namespace Thresholds;
 
@@ -15,7 +20,7 @@ AlertFlags AlertManager::evaluate(const SensorData& data){
     if (data.altitude > FLIGHT_CEIL) flags.aboveAltitudeCeiling = true;
 
     // IF off the ground
-    if (data.agl > 5.0){
+    if (data.agl > AIRBORNE_AGL){
         // IF speed is less than 47.0 knots or greater than 163.0 knots, add alert
         if (data.speed <= SPEED_LOW) flags.stallSpeed = true;
         if (data.speed > SPEED_HIGH) flags.overMaxSpeed = true;
@@ -41,18 +46,28 @@ AlertFlags AlertManager::evaluate(const SensorData& data){
         if (data.fuelFlow < FUEL_FLOW_LOW) flags.lowFuelFlow = true;
         if (data.fuelFlow > FUEL_FLOW_HIGH) flags.highFuelFlow = true;
 
+        // IF less than 45 minutes of fuel left at the current fuel flow, add alert
+        if (derived.endurance < ENDURANCE_LOW) flags.lowEndurance = true;
+
         // IF abs of pitch is greater than 30.0, add alert
-        if (abs(data.pitch) > PITCH_MAX) flags.pitchExceeded = true;
+        if (std::abs(data.pitch) > PITCH_MAX) flags.pitchExceeded = true;
         // IF abs of pitch rate is greater than 15.0, add alert
-        if (abs(data.pitchRate) > PITCH_RATE_MAX) flags.pitchRateExceeded = true;
+        if (std::abs(data.pitchRate) > PITCH_RATE_MAX) flags.pitchRateExceeded = true;
 
         // IF abs of roll is greater than 45.0, add alert
-        if (abs(data.roll) > ROLL_MAX) flags.rollExceeded = true;
+        if (std::abs(data.roll) > ROLL_MAX) flags.rollExceeded = true;
         // IF abs of roll rate is greater than 25.0, add alert
-        if (abs(data.rollRate) > ROLL_RATE_MAX) flags.rollRateExceeded = true;
+        if (std::abs(data.rollRate) > ROLL_RATE_MAX) flags.rollRateExceeded = true;
 
         // IF abs of yaw rate is greater than 20.0, add alert
-        if (abs(data.yawRate) > YAW_RATE_MAX) flags.yawRateExceeded = true;
+        if (std::abs(data.yawRate) > YAW_RATE_MAX) flags.yawRateExceeded = true;
     }
     return flags;
+}
+
+// Batch form used by the analyze stage, one call per drained batch
+void AlertManager::evaluate(PipelineSample* samples, std::size_t count){
+    for (std::size_t i = 0; i < count; ++i) {
+        samples[i].alerts = evaluate(samples[i].data, samples[i].derived);
+    }
 }
\ No newline at end of file
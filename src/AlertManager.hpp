@@ -1,13 +1,17 @@
 #pragma once
 
 #include "SensorData.hpp"
+#include "DerivedData.hpp"
 #include "AlertFlags.hpp"
+#include "PipelineSample.hpp"
+#include <cstddef>
 
 //Threshold for Cesna 172P SkyHawk
 namespace Thresholds{
     static constexpr double OP_TEMP_LOW = -23.8;//Fahrenheit
     static constexpr double OP_TEMP_HIGH = 104.0;//Fahrenheit
     static constexpr double FLIGHT_CEIL = 13500.0;//Feet
+    static constexpr double AIRBORNE_AGL = 5.0;//Feet, in-flight checks apply above this
     static constexpr double SPEED_LOW = 48.0;//Knots
     static constexpr double SPEED_HIGH = 158.0;//Knots
     static constexpr double HIGH_VERTICAL_SPEED = 800.0;//ft per minute
@@ -19,6 +23,7 @@ namespace Thresholds{
     static constexpr double FUEL_CAP_LOW = 6.0;//Gallons
     static constexpr double FUEL_FLOW_LOW = 5.0;
     static constexpr double FUEL_FLOW_HIGH = 20.0;
+    static constexpr double ENDURANCE_LOW = 45.0;//Minutes
     static constexpr double PITCH_MAX = 30.0;
     static constexpr double PITCH_RATE_MAX = 15.0;
     static constexpr double ROLL_MAX = 45.0;
@@ -30,4 +35,11 @@ class AlertManager{
 public:
     // Evaluate sensor data against thresholds and return triggered alerts
     static AlertFlags evaluate(const SensorData& data);
+
+    // Same, with the derived metrics already computed for data
+    static AlertFlags evaluate(const SensorData& data, const DerivedData& derived);
+
+    // Evaluate a batch of samples in place, filling in each sample's alerts.
+    // Reads each sample's derived metrics, so DerivedMetrics must run first
+    static void evaluate(PipelineSample* samples, std::size_t count);
 };
\ No newline at end of file
@@ -0,0 +1,449 @@
+#include "AlertRules.hpp"
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <utility>
+
+// Recursive descent compiler for one rule expression. Every sub-expression ends up
+// in a register, registers are handed out like a stack so a binary operation writes
+// into the lower of its two operands and frees the other. Constants stay out of
+// registers where an instruction can take them directly.
+class RuleParser {
+public:
+    RuleParser(AlertRules& rules, const std::string& text) : rules(rules), text(text) {}
+
+    // Compile "<expression> [for <n>s|ms]" into the rule's code, false with error set
+    bool compileRule(uint16_t ruleIndex, double& holdSeconds) {
+        Operand result;
+        if (!parseOr(result) || !materialize(result)) return false;
+
+        holdSeconds = 0.0;
+        skipSpace();
+        std::size_t start = pos;
+        if (readIdentifier() == "for") {
+            double amount;
+            if (!readNumber(amount)) return fail("expected a duration after 'for'");
+            std::string unit = readIdentifier();
+            if (unit == "s") holdSeconds = amount;
+            else if (unit == "ms") holdSeconds = amount / 1000.0;
+            else return fail("duration needs a unit, 's' or 'ms'");
+        } else {
+            pos = start;
+        }
+        skipSpace();
+        if (pos != text.size()) return fail("unexpected '" + text.substr(pos) + "'");
+
+        emit(AlertRules::RESULT, 0, result.reg, 0, ruleIndex);
+        return true;
+    }
+
+    std::string error;
+
+private:
+    // A value that is either in a register or a constant known at compile time
+    struct Operand {
+        bool isConst = false;
+        double value = 0.0;
+        int reg = 0;
+    };
+
+    AlertRules& rules;
+    const std::string& text;
+    std::size_t pos = 0;
+    int nextReg = 0;
+
+    bool fail(const std::string& message) {
+        if (error.empty()) error = message;
+        return false;
+    }
+
+    void skipSpace() {
+        while (pos < text.size() && std::isspace((unsigned char)text[pos])) ++pos;
+    }
+
+    // Consume token if it is next
+    bool match(const char* token) {
+        skipSpace();
+        std::size_t len = std::strlen(token);
+        if (text.compare(pos, len, token) != 0) return false;
+        pos += len;
+        return true;
+    }
+
+    std::string readIdentifier() {
+        skipSpace();
+        std::size_t start = pos;
+        while (pos < text.size() && (std::isalnum((unsigned char)text[pos]) || text[pos] == '_')) ++pos;
+        if (start < text.size() && std::isdigit((unsigned char)text[start])) {
+            pos = start; // A number, not an identifier
+            return "";
+        }
+        return text.substr(start, pos - start);
+    }
+
+    bool readNumber(double& value) {
+        skipSpace();
+        const char* begin = text.c_str() + pos;
+        if (!std::isdigit((unsigned char)*begin) && *begin != '.') return false;
+        char* end = nullptr;
+        value = std::strtod(begin, &end);
+        if (end == begin) return false;
+        pos += end - begin;
+        return true;
+    }
+
+    void emit(AlertRules::Op op, int dst, int a, int b, uint16_t arg) {
+        rules.code.push_back({op, (uint8_t)dst, (uint8_t)a, (uint8_t)b, arg});
+    }
+
+    bool allocate(int& reg) {
+        if (nextReg >= AlertRules::MAX_REGISTERS) return fail("expression is nested too deeply");
+        reg = nextReg++;
+        return true;
+    }
+
+    uint16_t constIndex(double value) {
+        for (std::size_t i = 0; i < rules.consts.size(); ++i)
+            if (rules.consts[i] == value) return (uint16_t)i;
+        rules.consts.push_back(value);
+        return (uint16_t)(rules.consts.size() - 1);
+    }
+
+    // Move a constant into a register
+    bool materialize(Operand& operand) {
+        if (!operand.isConst) return true;
+        if (!allocate(operand.reg)) return false;
+        emit(AlertRules::LOAD_CONST, operand.reg, 0, 0, constIndex(operand.value));
+        operand.isConst = false;
+        return true;
+    }
+
+    // left = left <op> right
+    bool emitBinary(AlertRules::Op op, Operand& left, Operand& right) {
+        // Comparisons against a constant read it straight from the pool
+        static const AlertRules::Op constForm[] = {AlertRules::LT_CONST, AlertRules::LE_CONST,
+                                                   AlertRules::GT_CONST, AlertRules::GE_CONST};
+        static const AlertRules::Op mirrored[] = {AlertRules::GT, AlertRules::GE, AlertRules::LT, AlertRules::LE};
+        const bool ordered = op >= AlertRules::LT && op <= AlertRules::GE;
+        if (ordered && left.isConst && !right.isConst) { // 5 < x is x > 5
+            std::swap(left, right);
+            op = mirrored[op - AlertRules::LT];
+        }
+        if (ordered && right.isConst && !left.isConst) {
+            AlertRules::Instruction& last = rules.code.back();
+            if (last.op == AlertRules::LOAD_CHANNEL && last.dst == left.reg) { // "speed > 158" is one instruction
+                last = {(AlertRules::Op)(AlertRules::CHANNEL_LT_CONST + (op - AlertRules::LT)), (uint8_t)left.reg, 0,
+                        (uint8_t)last.arg, constIndex(right.value)};
+            } else {
+                emit(constForm[op - AlertRules::LT], left.reg, left.reg, 0, constIndex(right.value));
+            }
+            return true;
+        }
+
+        if (!materialize(left) || !materialize(right)) return false;
+        const int dst = std::min(left.reg, right.reg);
+        emit(op, dst, left.reg, right.reg, 0);
+        left.reg = dst;
+        nextReg = dst + 1;
+        return true;
+    }
+
+    // or := and ('||' and)*
+    bool parseOr(Operand& out) {
+        if (!parseAnd(out)) return false;
+        while (match("||")) {
+            Operand right;
+            if (!parseAnd(right) || !emitBinary(AlertRules::OR, out, right)) return false;
+        }
+        return true;
+    }
+
+    // and := comparison ('&&' comparison)*
+    bool parseAnd(Operand& out) {
+        if (!parseComparison(out)) return false;
+        while (match("&&")) {
+            Operand right;
+            if (!parseComparison(right) || !emitBinary(AlertRules::AND, out, right)) return false;
+        }
+        return true;
+    }
+
+    // comparison := sum [('<' | '<=' | '>' | '>=' | '==' | '!=') sum]
+    bool parseComparison(Operand& out) {
+        if (!parseSum(out)) return false;
+        AlertRules::Op op;
+        if (match("<=")) op = AlertRules::LE;
+        else if (match(">=")) op = AlertRules::GE;
+        else if (match("==")) op = AlertRules::EQ;
+        else if (match("!=")) op = AlertRules::NE;
+        else if (match("<")) op = AlertRules::LT;
+        else if (match(">")) op = AlertRules::GT;
+        else return true;
+        Operand right;
+        return parseSum(right) && emitBinary(op, out, right);
+    }
+
+    // sum := product (('+' | '-') product)*
+    bool parseSum(Operand& out) {
+        if (!parseProduct(out)) return false;
+        for (;;) {
+            AlertRules::Op op;
+            if (match("+")) op = AlertRules::ADD;
+            else if (match("-")) op = AlertRules::SUB;
+            else return true;
+            Operand right;
+            if (!parseProduct(right) || !emitBinary(op, out, right)) return false;
+        }
+    }
+
+    // product := unary (('*' | '/') unary)*
+    bool parseProduct(Operand& out) {
+        if (!parseUnary(out)) return false;
+        for (;;) {
+            AlertRules::Op op;
+            if (match("*")) op = AlertRules::MUL;
+            else if (match("/")) op = AlertRules::DIV;
+            else return true;
+            Operand right;
+            if (!parseUnary(right) || !emitBinary(op, out, right)) return false;
+        }
+    }
+
+    // unary := ('-' | '!') unary | primary
+    bool parseUnary(Operand& out) {
+        AlertRules::Op op;
+        if (match("-")) op = AlertRules::NEG;
+        else if (match("!")) op = AlertRules::NOT;
+        else return parsePrimary(out);
+
+        if (!parseUnary(out)) return false;
+        return emitUnary(op, out);
+    }
+
+    bool emitUnary(AlertRules::Op op, Operand& out) {
+        if (out.isConst) { // Folded, so "-23.8" is one constant
+            if (op == AlertRules::NEG) out.value = -out.value;
+            else if (op == AlertRules::NOT) out.value = out.value == 0.0;
+            else out.value = std::fabs(out.value);
+            return true;
+        }
+        AlertRules::Instruction& last = rules.code.back();
+        if (op == AlertRules::ABS && last.op == AlertRules::LOAD_CHANNEL && last.dst == out.reg) {
+            last.op = AlertRules::LOAD_ABS_CHANNEL;
+            return true;
+        }
+        emit(op, out.reg, out.reg, 0, 0);
+        return true;
+    }
+
+    // primary := number | channel | abs(expr) | min(expr, expr) | max(expr, expr) | '(' expr ')'
+    bool parsePrimary(Operand& out) {
+        if (readNumber(out.value)) {
+            out.isConst = true;
+            return true;
+        }
+        if (match("(")) {
+            if (!parseOr(out)) return false;
+            return match(")") || fail("missing ')'");
+        }
+
+        std::string name = readIdentifier();
+        if (name.empty()) {
+            skipSpace();
+            return fail(pos < text.size() ? "unexpected '" + text.substr(pos, 1) + "'" : "expression ends early");
+        }
+
+        if (name == "abs" || name == "min" || name == "max") {
+            if (!match("(")) return fail("expected '(' after " + name);
+            if (!parseOr(out)) return false;
+            if (name == "abs") {
+                if (!emitUnary(AlertRules::ABS, out)) return false;
+            } else {
+                Operand second;
+                if (!match(",")) return fail(name + " takes two arguments");
+                if (!parseOr(second)) return false;
+                if (!emitBinary(name == "min" ? AlertRules::MIN : AlertRules::MAX, out, second)) return false;
+            }
+            return match(")") || fail("missing ')' after " + name + " arguments");
+        }
+
+        for (int c = 0; c < SENSOR_CHANNEL_COUNT; ++c) {
+            if (name == CHANNEL_IDENTIFIERS[c]) {
+                if (!allocate(out.reg)) return false;
+                emit(AlertRules::LOAD_CHANNEL, out.reg, 0, 0, (uint16_t)c);
+                out.isConst = false;
+                return true;
+            }
+        }
+        for (int c = 0; c < DERIVED_CHANNEL_COUNT; ++c) { // Read after the SensorData channels
+            if (name == DERIVED_IDENTIFIERS[c]) {
+                if (!allocate(out.reg)) return false;
+                emit(AlertRules::LOAD_CHANNEL, out.reg, 0, 0, (uint16_t)(SENSOR_CHANNEL_COUNT + c));
+                out.isConst = false;
+                return true;
+            }
+        }
+        return fail("unknown channel '" + name + "'");
+    }
+};
+
+/*-------------------------------------------------------------------------------------
+// Title: AlertRules::compile
+// Description:
+// Compile every "NAME: expression [for <n>s]" line of text into one program. Blank
+// lines and lines starting with # are skipped. A rule named like a built-in alert
+// drives that AlertFlags bit, any other name becomes the next customAlerts bit.
+-------------------------------------------------------------------------------------*/
+bool AlertRules::compile(const std::string& text, std::string& error) {
+    code.clear();
+    consts.clear();
+    rules.clear();
+    customNames.clear();
+
+    std::istringstream lines(text);
+    std::string line;
+    int lineNumber = 0;
+    while (std::getline(lines, line)) {
+        ++lineNumber;
+        if (!line.empty() && line.back() == '\r') line.pop_back();
+        std::size_t first = line.find_first_not_of(" \t");
+        if (first == std::string::npos || line[first] == '#') continue;
+
+        std::size_t colon = line.find(':');
+        if (colon == first) colon = std::string::npos; // No name
+        std::size_t nameEnd = colon == std::string::npos ? colon : line.find_last_not_of(" \t", colon - 1);
+        if (colon == std::string::npos) {
+            error = "line " + std::to_string(lineNumber) + ": expected 'NAME: expression'";
+            return false;
+        }
+
+        Rule rule;
+        rule.name = line.substr(first, nameEnd - first + 1);
+        for (const Rule& other : rules) {
+            if (other.name == rule.name) {
+                error = "line " + std::to_string(lineNumber) + ": rule '" + rule.name + "' is defined twice";
+                return false;
+            }
+        }
+        for (int i = 0; i < ALERT_COUNT; ++i)
+            if (rule.name == ALERT_NAMES[i]) rule.alertBit = 1u << i;
+        if (!rule.alertBit) {
+            if ((int)customNames.size() == MAX_CUSTOM_RULES) {
+                error = "line " + std::to_string(lineNumber) + ": more than " +
+                        std::to_string(MAX_CUSTOM_RULES) + " custom rules";
+                return false;
+            }
+            rule.customBit = 1u << customNames.size();
+            customNames.push_back(rule.name);
+        }
+
+        const std::string expression = line.substr(colon + 1);
+        RuleParser parser(*this, expression);
+        if (!parser.compileRule((uint16_t)rules.size(), rule.holdSeconds)) {
+            error = "line " + std::to_string(lineNumber) + ": " + parser.error;
+            return false;
+        }
+        rules.push_back(rule);
+    }
+    return true;
+}// End of AlertRules::compile
+
+bool AlertRules::load(const std::string& path) {
+    std::ifstream file(path);
+    if (!file.is_open()) {
+        std::cerr << "[AlertRules] Could not open " << path << std::endl;
+        return false;
+    }
+    std::stringstream contents;
+    contents << file.rdbuf();
+
+    std::string error;
+    if (!compile(contents.str(), error)) {
+        std::cerr << "[AlertRules] " << path << " " << error << std::endl;
+        return false;
+    }
+    std::cout << "[AlertRules] " << rules.size() << " rules (" << customNames.size() << " custom) in "
+              << code.size() << " instructions from " << path << "\n";
+    return true;
+}
+
+/*-------------------------------------------------------------------------------------
+// Title: AlertRules::evaluate
+// Description:
+// Run the whole program for one sample. Registers are a local array and every rule's
+// code is straight line, so this is one pass over code with no allocation or calls.
+// The sample's channels and derived metrics are copied into one local array first, so
+// a channel operand is a single index either way. A RESULT instruction applies the
+// rule's "for" hold, then sets its alert bit.
+-------------------------------------------------------------------------------------*/
+uint32_t AlertRules::evaluate(const SensorData& data, const DerivedData& derived, double time,
+                              uint32_t& customMask) {
+    double channels[SENSOR_CHANNEL_COUNT + DERIVED_CHANNEL_COUNT];
+    std::memcpy(channels, &data, sizeof(SensorData));
+    std::memcpy(channels + SENSOR_CHANNEL_COUNT, &derived, sizeof(DerivedData));
+    const double* k = consts.data();
+    double reg[MAX_REGISTERS];
+    uint32_t alertMask = 0;
+    customMask = 0;
+
+    for (const Instruction& in : code) {
+        switch (in.op) {
+            case LOAD_CHANNEL: reg[in.dst] = channels[in.arg]; break;
+            case LOAD_CONST:   reg[in.dst] = k[in.arg]; break;
+            case ADD: reg[in.dst] = reg[in.a] + reg[in.b]; break;
+            case SUB: reg[in.dst] = reg[in.a] - reg[in.b]; break;
+            case MUL: reg[in.dst] = reg[in.a] * reg[in.b]; break;
+            case DIV: reg[in.dst] = reg[in.a] / reg[in.b]; break;
+            case MIN: reg[in.dst] = std::fmin(reg[in.a], reg[in.b]); break;
+            case MAX: reg[in.dst] = std::fmax(reg[in.a], reg[in.b]); break;
+            case LT: reg[in.dst] = reg[in.a] < reg[in.b]; break;
+            case LE: reg[in.dst] = reg[in.a] <= reg[in.b]; break;
+            case GT: reg[in.dst] = reg[in.a] > reg[in.b]; break;
+            case GE: reg[in.dst] = reg[in.a] >= reg[in.b]; break;
+            case EQ: reg[in.dst] = reg[in.a] == reg[in.b]; break;
+            case NE: reg[in.dst] = reg[in.a] != reg[in.b]; break;
+            case LT_CONST: reg[in.dst] = reg[in.a] < k[in.arg]; break;
+            case LE_CONST: reg[in.dst] = reg[in.a] <= k[in.arg]; break;
+            case GT_CONST: reg[in.dst] = reg[in.a] > k[in.arg]; break;
+            case GE_CONST: reg[in.dst] = reg[in.a] >= k[in.arg]; break;
+            case CHANNEL_LT_CONST: reg[in.dst] = channels[in.b] < k[in.arg]; break;
+            case CHANNEL_LE_CONST: reg[in.dst] = channels[in.b] <= k[in.arg]; break;
+            case CHANNEL_GT_CONST: reg[in.dst] = channels[in.b] > k[in.arg]; break;
+            case CHANNEL_GE_CONST: reg[in.dst] = channels[in.b] >= k[in.arg]; break;
+            case LOAD_ABS_CHANNEL: reg[in.dst] = std::fabs(channels[in.arg]); break;
+            case AND: reg[in.dst] = (reg[in.a] != 0.0) & (reg[in.b] != 0.0); break;
+            case OR:  reg[in.dst] = (reg[in.a] != 0.0) | (reg[in.b] != 0.0); break;
+            case NOT: reg[in.dst] = reg[in.a] == 0.0; break;
+            case NEG: reg[in.dst] = -reg[in.a]; break;
+            case ABS: reg[in.dst] = std::fabs(reg[in.a]); break;
+            case RESULT: {
+                Rule& rule = rules[in.arg];
+                bool active = reg[in.a] != 0.0;
+                if (rule.holdSeconds > 0.0) {
+                    if (active && !rule.holding) rule.since = time;
+                    rule.holding = active;
+                    active = active && time - rule.since >= rule.holdSeconds;
+                }
+                if (active) {
+                    alertMask |= rule.alertBit;
+                    customMask |= rule.customBit;
+                }
+                break;
+            }
+        }
+    }
+    return alertMask;
+}// End of AlertRules::evaluate
+
+// Batch form used by the analyze stage in place of AlertManager::evaluate
+void AlertRules::evaluate(PipelineSample* samples, std::size_t count) {
+    for (std::size_t i = 0; i < count; ++i) {
+        samples[i].alerts = fromAlertMask(evaluate(samples[i].data, samples[i].derived, samples[i].time,
+                                                       samples[i].customAlerts));
+    }
+}
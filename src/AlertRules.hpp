@@ -0,0 +1,86 @@
+#pragma once
+
+#include "SensorData.hpp"
+#include "DerivedData.hpp"
+#include "PipelineSample.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Alert rules loaded from a text file at startup (--rules=<file>), one per line:
+//
+//   # comment
+//   STALL SPEED: agl > 5 && speed <= 48
+//   SUSTAINED PITCH RATE: agl > 5 && abs(pitchRate) > 15 for 2s
+//
+// Expressions use the SensorData and DerivedData field names (e.g. endurance),
+// numbers, + - * / ( ), comparisons < <= > >= == !=, && || !, and abs(x), min(a,b),
+// max(a,b). "for <n>s" (or ms) only raises the alert once the condition has held
+// that long.
+//
+// Rules named like a built-in alert (ALERT_NAMES) set that AlertFlags bit, so the
+// Cessna limits in AlertManager can be written as rules (see alert_rules.txt). Other
+// rules are custom alerts and set a bit of PipelineSample::customAlerts.
+//
+// Every rule is compiled once into one flat register bytecode program. Evaluating a
+// sample is a single switch loop over it, with no allocation and no virtual calls.
+class AlertRules {
+public:
+    static constexpr int MAX_CUSTOM_RULES = 32; // customAlerts is a uint32_t mask
+    static constexpr int MAX_REGISTERS = 16;    // Deepest expression nesting
+
+    // Read and compile a rules file, prints the first error and returns false
+    bool load(const std::string& path);
+
+    // Compile rules from text, replacing any loaded before. Sets error to
+    // "line <n>: <message>" and returns false on the first bad line
+    bool compile(const std::string& text, std::string& error);
+
+    // Evaluate every rule for the batch, fills in alerts and customAlerts
+    void evaluate(PipelineSample* samples, std::size_t count);
+
+    // Evaluate one sample at time (seconds), returns the built-in alert mask
+    uint32_t evaluate(const SensorData& data, const DerivedData& derived, double time, uint32_t& customMask);
+
+    std::size_t ruleCount() const { return rules.size(); }
+    const std::vector<std::string>& getCustomNames() const { return customNames; } // Index = customAlerts bit
+    std::size_t getInstructionCount() const { return code.size(); }
+
+private:
+    enum Op : uint8_t {
+        LOAD_CHANNEL, LOAD_CONST,
+        ADD, SUB, MUL, DIV, MIN, MAX,
+        LT, LE, GT, GE, EQ, NE,
+        LT_CONST, LE_CONST, GT_CONST, GE_CONST, // Right operand is consts[arg]
+        CHANNEL_LT_CONST, CHANNEL_LE_CONST,     // Left operand is channel b, fused load
+        CHANNEL_GT_CONST, CHANNEL_GE_CONST,
+        LOAD_ABS_CHANNEL,
+        AND, OR, NOT, NEG, ABS,
+        RESULT                                  // Rule arg is reg[a] != 0
+    };
+
+    // dst = a <op> b, arg is a channel, constant or rule index depending on op
+    struct Instruction {
+        Op op;
+        uint8_t dst;
+        uint8_t a;
+        uint8_t b;
+        uint16_t arg;
+    };
+
+    struct Rule {
+        std::string name;
+        double holdSeconds = 0.0; // "for" duration
+        uint32_t alertBit = 0;    // Built-in alert mask bit, or 0
+        uint32_t customBit = 0;   // customAlerts bit, or 0
+        bool holding = false;     // Condition true on the last sample
+        double since = 0.0;       // Time the condition became true
+    };
+
+    friend class RuleParser;
+    std::vector<Instruction> code;
+    std::vector<double> consts;
+    std::vector<Rule> rules;
+    std::vector<std::string> customNames;
+};
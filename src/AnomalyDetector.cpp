@@ -0,0 +1,128 @@
+#include "AnomalyDetector.hpp"
+#include <algorithm>
+#include <cmath>
+
+// Sigma never drops below roughly the sensor's resolution, so a signal that has been
+// flat for a while doesn't flag its first small change
+const double AnomalyDetector::NOISE_FLOOR[SENSOR_CHANNEL_COUNT] = {
+    0.5,   // temperature F
+    5.0,   // altitude ft
+    1.0,   // agl ft
+    1.0,   // speed kt
+    20.0,  // vertical speed fpm
+    10.0,  // engine rpm
+    1.0,   // throttle %
+    0.5,   // oil pressure psi
+    0.5,   // oil temperature F
+    0.05,  // fuel gal
+    0.1,   // fuel flow gph
+    0.2,   // pitch deg
+    0.2,   // pitch rate deg/s
+    0.2,   // roll deg
+    0.2,   // roll rate deg/s
+    0.5,   // yaw deg
+    0.2    // yaw rate deg/s
+};
+
+// Yaw wraps at +-180, differences are taken the short way round
+static double wrapDegrees(double angle) {
+    if (angle > 180.0) return angle - 360.0;
+    if (angle < -180.0) return angle + 360.0;
+    return angle;
+}
+
+// Constructor
+AnomalyDetector::AnomalyDetector() {
+    for (int c = 0; c < SENSOR_CHANNEL_COUNT; ++c) {
+        mean[c] = variance[c] = baseline[c] = cusumHigh[c] = cusumLow[c] = 0.0;
+    }
+}
+
+/*-------------------------------------------------------------------------------------
+// Title: AnomalyDetector::process
+// Description:
+// Test one sample against the running statistics of every channel, then fold it in.
+// spike: |x - mean| > Z_LIMIT sigma, compared squared so no sqrt is needed.
+// drift: CUSUM of (x - baseline) / sigma with slack CUSUM_SLACK, either side above
+//        CUSUM_LIMIT. The baseline moves ~25x slower than the mean, so slow creep
+//        builds up in the sums while noise around the mean does not. A channel's
+//        sums restart from zero after it raised drift.
+// Until DRIFT_WARMUP the baseline is the plain mean of the samples so far, so it
+// starts from that average instead of one noisy reading the slow EWMA would need
+// ~1/SLOW_ALPHA samples to forget, and the sums stay at zero. No flags during WARMUP.
+// Each step is one branch free loop over all channels, yaw is wrapped in between.
+-------------------------------------------------------------------------------------*/
+AnomalyFlags AnomalyDetector::process(const SensorData& data) {
+    using namespace AnomalyThresholds;
+    const double* x = reinterpret_cast<const double*>(&data);
+
+    AnomalyFlags flags;
+
+    // First sample seeds the statistics
+    if (samples == 0) {
+        for (int c = 0; c < SENSOR_CHANNEL_COUNT; ++c) {
+            mean[c] = baseline[c] = x[c];
+        }
+        ++samples;
+        return flags;
+    }
+
+    alignas(32) double dev[SENSOR_CHANNEL_COUNT];   // x - mean
+    alignas(32) double drift[SENSOR_CHANNEL_COUNT]; // x - baseline
+    alignas(32) double sigma2[SENSOR_CHANNEL_COUNT];
+    for (int c = 0; c < SENSOR_CHANNEL_COUNT; ++c) {
+        dev[c] = x[c] - mean[c];
+        drift[c] = x[c] - baseline[c];
+        sigma2[c] = std::max(variance[c], NOISE_FLOOR[c] * NOISE_FLOOR[c]);
+    }
+
+    dev[CH_YAW] = wrapDegrees(dev[CH_YAW]);
+    drift[CH_YAW] = wrapDegrees(drift[CH_YAW]);
+
+    // Tests
+    uint32_t spike = 0, shift = 0;
+    for (int c = 0; c < SENSOR_CHANNEL_COUNT; ++c) {
+        double z = drift[c] / std::sqrt(sigma2[c]);
+        cusumHigh[c] = std::max(0.0, cusumHigh[c] + z - CUSUM_SLACK);
+        cusumLow[c] = std::max(0.0, cusumLow[c] - z - CUSUM_SLACK);
+
+        spike |= (uint32_t)(dev[c] * dev[c] > Z_LIMIT * Z_LIMIT * sigma2[c]) << c;
+        shift |= (uint32_t)(cusumHigh[c] > CUSUM_LIMIT || cusumLow[c] > CUSUM_LIMIT) << c;
+    }
+
+    // A raised drift starts the next one from zero
+    for (int c = 0; c < SENSOR_CHANNEL_COUNT; ++c) {
+        double keep = (shift >> c) & 1u ? 0.0 : 1.0;
+        cusumHigh[c] *= keep;
+        cusumLow[c] *= keep;
+    }
+
+    // Fold the sample in (West's EWMA variance update). The baseline is a running
+    // mean of the samples seen until DRIFT_WARMUP, the slow EWMA afterwards
+    const double baseAlpha = samples < DRIFT_WARMUP ? 1.0 / (samples + 1) : SLOW_ALPHA;
+    for (int c = 0; c < SENSOR_CHANNEL_COUNT; ++c) {
+        variance[c] = (1.0 - FAST_ALPHA) * (variance[c] + FAST_ALPHA * dev[c] * dev[c]);
+        mean[c] += FAST_ALPHA * dev[c];
+        baseline[c] += baseAlpha * drift[c];
+    }
+    mean[CH_YAW] = wrapDegrees(mean[CH_YAW]);
+    baseline[CH_YAW] = wrapDegrees(baseline[CH_YAW]);
+
+    // Statistics are still settling: no flags before WARMUP, no drift sums before
+    // DRIFT_WARMUP. The count stops there, the baseline is an EWMA from then on
+    if (samples < DRIFT_WARMUP) {
+        for (int c = 0; c < SENSOR_CHANNEL_COUNT; ++c) cusumHigh[c] = cusumLow[c] = 0.0;
+        shift = 0;
+        if (samples++ < WARMUP) return flags;
+    }
+    flags.spike = spike;
+    flags.drift = shift;
+    return flags;
+}// End of process
+
+// Batch form used by the analyze stage, one call per drained batch
+void AnomalyDetector::process(PipelineSample* batch, std::size_t count) {
+    for (std::size_t i = 0; i < count; ++i) {
+        batch[i].anomalies = process(batch[i].data);
+    }
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+#include "SensorData.hpp"
+#include "AnomalyFlags.hpp"
+#include "PipelineSample.hpp"
+#include <cstddef>
+#include <cstdint>
+
+// Tuning of the statistical detector, in units of each channel's running sigma
+namespace AnomalyThresholds {
+    static constexpr double FAST_ALPHA = 0.05;   // EWMA weight for mean/variance (~20 samples)
+    static constexpr double SLOW_ALPHA = 0.002;  // EWMA weight for the CUSUM baseline (~500 samples)
+    static constexpr double Z_LIMIT = 4.0;       // Spike when |x - mean| > 4 sigma
+    static constexpr double CUSUM_SLACK = 0.5;   // k, deviation ignored per sample
+    static constexpr double CUSUM_LIMIT = 10.0;  // h, drift alarm level
+    static constexpr uint32_t WARMUP = 50;       // Samples before any flag is raised
+    static constexpr uint32_t DRIFT_WARMUP = 500; // ~1/SLOW_ALPHA, samples before drift is raised
+};// AnomalyThresholds
+
+// Streaming anomaly detection that runs next to the fixed AlertManager thresholds.
+// Per channel it keeps an EWMA mean/variance (z-score spikes) and a two sided CUSUM
+// of the deviation from a slow EWMA baseline (creep and level shifts that stay inside
+// the limits). State is a few arrays of SENSOR_CHANNEL_COUNT doubles, so memory is
+// constant, and a sample is processed as straight loops over all channels at once.
+class AnomalyDetector {
+public:
+    AnomalyDetector();
+
+    // Update with one sample and return the channels that look anomalous
+    AnomalyFlags process(const SensorData& data);
+
+    // Batch form used by the analyze stage, fills in each sample's anomalies
+    void process(PipelineSample* samples, std::size_t count);
+
+private:
+    alignas(32) double mean[SENSOR_CHANNEL_COUNT];     // Fast EWMA mean
+    alignas(32) double variance[SENSOR_CHANNEL_COUNT]; // Fast EWMA variance
+    alignas(32) double baseline[SENSOR_CHANNEL_COUNT]; // Slow EWMA mean, CUSUM reference
+    alignas(32) double cusumHigh[SENSOR_CHANNEL_COUNT];
+    alignas(32) double cusumLow[SENSOR_CHANNEL_COUNT];
+    uint32_t samples = 0;
+
+    // Smallest sigma per channel, keeps flat signals quiet
+    static const double NOISE_FLOOR[SENSOR_CHANNEL_COUNT];
+};
@@ -0,0 +1,11 @@
+#pragma once
+
+#include <cstdint>
+
+// Channels the statistical detector flagged for one sample, bit = SensorChannel
+struct AnomalyFlags {
+    uint32_t spike = 0; // EWMA z-score beyond the limit, sudden jump
+    uint32_t drift = 0; // CUSUM beyond the limit, slow creep or level shift
+
+    uint32_t any() const { return spike | drift; }
+};
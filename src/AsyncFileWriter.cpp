@@ -0,0 +1,85 @@
+#include "AsyncFileWriter.hpp"
+#include <iostream>
+
+AsyncFileWriter::AsyncFileWriter() = default;
+
+AsyncFileWriter::~AsyncFileWriter() {
+    close();
+}
+
+bool AsyncFileWriter::open(const std::string& path) {
+    close();
+    file.open(path, std::ios::out | std::ios::app);
+    if (!file.is_open()) {
+        std::cerr << "[AsyncFileWriter] Error when trying to open " << path << std::endl;
+        return false;
+    }
+    stopping = false;
+    writer = std::thread([this] { writerLoop(); });
+    return true;
+}
+
+// Copy into the pending buffer, the writer takes all of it at once
+void AsyncFileWriter::append(const char* data, std::size_t size) {
+    if (!file.is_open() || size == 0) return;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        queued.append(data, size);
+        if (queued.size() > peak) peak = queued.size();
+    }
+    ready.notify_one();
+}
+
+void AsyncFileWriter::drain() {
+    std::unique_lock<std::mutex> lock(mutex);
+    done.wait(lock, [this] { return queued.empty() && !busy; });
+}
+
+void AsyncFileWriter::close() {
+    if (!writer.joinable()) return;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    ready.notify_one();
+    writer.join();
+    file.close();
+}
+
+std::size_t AsyncFileWriter::pending() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return queued.size() + (busy ? writing.size() : 0);
+}
+
+/*-------------------------------------------------------------------------------------
+// Title: AsyncFileWriter::writerLoop
+// Description:
+// Swap out everything appended since the last pass and write it with one write and
+// flush, the same pattern as Logger's threaded sink. The lock is only held for the
+// swap, so append never waits for the disk. Pending bytes are written before stopping.
+-------------------------------------------------------------------------------------*/
+void AsyncFileWriter::writerLoop() {
+    std::unique_lock<std::mutex> lock(mutex);
+    for (;;) {
+        if (queued.empty()) {
+            if (stopping) return;
+            ready.wait(lock);
+            continue;
+        }
+        writing.clear();
+        writing.swap(queued);
+        busy = true;
+
+        lock.unlock();
+        file.write(writing.data(), writing.size());
+        file.flush();
+        if (!file) {
+            if (failed++ == 0) std::cerr << "[AsyncFileWriter] Write failed" << std::endl;
+            file.clear();
+        }
+        lock.lock();
+
+        busy = false;
+        done.notify_all();
+    }
+}// End of writerLoop
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+
+// Appends to a file from a writer thread of its own, for --reactor where one thread
+// also reads the socket. append copies the bytes into a pending buffer and returns,
+// the writer swaps that buffer out and writes and flushes it in one call, so the
+// caller never waits for the disk. Like the CSV channel in threaded mode nothing is
+// dropped: while the disk is behind the pending buffer grows, its peak is kept.
+class AsyncFileWriter {
+public:
+    AsyncFileWriter();
+    ~AsyncFileWriter();
+    AsyncFileWriter(const AsyncFileWriter&) = delete;
+    AsyncFileWriter& operator=(const AsyncFileWriter&) = delete;
+
+    // Open path for appending after its current end and start the writer, false if
+    // it can't be opened
+    bool open(const std::string& path);
+    bool isOpen() const { return file.is_open(); }
+
+    // Queue a copy of data for the writer and return without waiting
+    void append(const char* data, std::size_t size);
+
+    // Wait until everything appended so far is written and flushed
+    void drain();
+
+    // Write what is still pending, stop the writer and close the file
+    void close();
+
+    std::size_t pending() const;                  // Bytes appended, not written yet
+    std::size_t peakPending() const { return peak; } // Most bytes ever pending
+    uint64_t failedWrites() const { return failed.load(); }
+
+private:
+    std::ofstream file;            // Writer thread only while it runs
+    std::thread writer;
+    mutable std::mutex mutex;
+    std::condition_variable ready; // Bytes queued, or stopping
+    std::condition_variable done;  // The writer finished a buffer
+    std::string queued;            // Appended since the writer last took the buffer
+    std::string writing;           // Writer thread only, swapped with queued
+    bool busy = false;             // The writer holds a buffer
+    bool stopping = false;
+    std::size_t peak = 0;
+    std::atomic<uint64_t> failed{0};
+
+    void writerLoop();
+};
@@ -0,0 +1,73 @@
+#include "BinaryLogger.hpp"
+#include <cstring>
+#include <iostream>
+
+static_assert(sizeof(SensorData) == sizeof(BinaryLogRecord::values), "SensorData must be 17 packed doubles");
+
+// Constructor
+BinaryLogger::BinaryLogger(BinaryLogFormat format) : format(format) {
+    output.open("data/sensor_log.bin", std::ios::out | std::ios::binary | std::ios::trunc);
+    if (!output.is_open()) {
+        std::cerr << "[BinaryLogger] Error when trying to open file" << std::endl;
+        return;
+    }
+
+    // Header so readers can check the layout before parsing records
+    const char magic[8] = {'C', '1', '7', '2', 'B', 'L', 'O', 'G'};
+    const bool compact = (format == BinaryLogFormat::Compact);
+    const uint32_t version = compact ? 2 : 1;
+    const uint32_t recordSize = compact ? sizeof(PackedSample) : sizeof(BinaryLogRecord);
+    output.write(magic, sizeof(magic));
+    output.write(reinterpret_cast<const char*>(&version), sizeof(version));
+    output.write(reinterpret_cast<const char*>(&recordSize), sizeof(recordSize));
+}
+
+// Deconstructor
+BinaryLogger::~BinaryLogger() {
+    if (output.is_open()) output.close();
+}
+
+// Fill a record from an evaluated sample
+static BinaryLogRecord toRecord(const PipelineSample& sample) {
+    BinaryLogRecord record{};
+    record.seq = sample.seq;
+    record.time = sample.time;
+    std::memcpy(record.values, &sample.data, sizeof(record.values));
+    record.alertMask = toAlertMask(sample.alerts);
+    record.anomalyMask = sample.anomalies.any();
+    return record;
+}
+
+// Append one record, buffered until the sink goes idle
+void BinaryLogger::consume(const PipelineSample& sample) {
+    if (!output.is_open()) return;
+
+    if (format == BinaryLogFormat::Compact) {
+        PackedSample record = packSample(sample);
+        output.write(reinterpret_cast<const char*>(&record), sizeof(record));
+        return;
+    }
+    BinaryLogRecord record = toRecord(sample);
+    output.write(reinterpret_cast<const char*>(&record), sizeof(record));
+}
+
+// Append a whole batch with a single write
+void BinaryLogger::consumeBatch(const std::vector<PipelineSample>& batch) {
+    if (!output.is_open()) return;
+
+    if (format == BinaryLogFormat::Compact) {
+        packed.clear();
+        for (const PipelineSample& sample : batch) packed.push_back(packSample(sample));
+        output.write(reinterpret_cast<const char*>(packed.data()), packed.size() * sizeof(PackedSample));
+        return;
+    }
+
+    records.clear();
+    for (const PipelineSample& sample : batch) records.push_back(toRecord(sample));
+    output.write(reinterpret_cast<const char*>(records.data()), records.size() * sizeof(BinaryLogRecord));
+}
+
+// Caught up with the pipeline, push buffered records to disk
+void BinaryLogger::idle() {
+    if (output.is_open()) output.flush();
+}
@@ -0,0 +1,37 @@
+#pragma once
+
+#include "Pipeline.hpp"
+#include "PackedSample.hpp"
+#include "Config.hpp"
+#include <cstdint>
+#include <fstream>
+#include <vector>
+
+// Fixed-size full precision record, host byte order (little endian on x86)
+struct BinaryLogRecord {
+    uint64_t seq;
+    double time;
+    double values[17];  // SensorData fields in declaration order
+    uint32_t alertMask;   // toAlertMask bits
+    uint32_t anomalyMask; // Channels AnomalyDetector flagged (spike or drift), 0 before it existed
+};
+
+// Sink writing every evaluated sample to data/sensor_log.bin.
+// File starts with an 8 byte magic "C172BLOG", then uint32 version and uint32 record size.
+// Version 1 records are BinaryLogRecord, version 2 records are PackedSample.
+class BinaryLogger : public Sink {
+public:
+    explicit BinaryLogger(BinaryLogFormat format = BinaryLogFormat::Full);
+    ~BinaryLogger();
+
+    const char* name() const override { return "binary log"; }
+    void consume(const PipelineSample& sample) override;
+    void consumeBatch(const std::vector<PipelineSample>& batch) override;
+    void idle() override;
+
+private:
+    BinaryLogFormat format;
+    std::ofstream output;
+    std::vector<BinaryLogRecord> records; // Reused between batches
+    std::vector<PackedSample> packed;     // Reused between batches, compact format
+};
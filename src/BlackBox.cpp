@@ -0,0 +1,193 @@
+#include "BlackBox.hpp"
+#include <cmath>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+
+// Room a capture row takes in the CSV, used to respect the disk cap before writing
+static constexpr std::size_t ESTIMATED_ROW_BYTES = 460;
+
+// Constructor
+BlackBox::BlackBox(uint32_t triggerMask, double preSeconds, double postSeconds, std::size_t maxDiskMB,
+                   const std::string& directory)
+: triggerMask(triggerMask), preSeconds(preSeconds), postSeconds(postSeconds),
+  maxDiskBytes((uint64_t)maxDiskMB * 1024 * 1024), directory(directory) {
+    std::error_code error;
+    std::filesystem::create_directories(directory, error);
+    if (error) std::cerr << "[BlackBox] Could not create " << directory << ": " << error.message() << std::endl;
+
+    // Every buffer is sized once here, capture never allocates
+    const std::size_t ringSize = (std::size_t)std::ceil(preSeconds * MAX_RATE_HZ) + 1;
+    const std::size_t postSize = (std::size_t)std::ceil(postSeconds * MAX_RATE_HZ) + 1;
+    ring.resize(ringSize);
+    for (Capture& capture : captures) capture.samples.reserve(ringSize + postSize);
+
+    writer = std::thread([this] { writerLoop(); });
+}
+
+// Deconstructor
+BlackBox::~BlackBox() {
+    // Save what the captures still collecting have so far
+    for (Capture& capture : captures) {
+        if (capture.state == SlotState::Collecting) finishCapture(capture);
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    ready.notify_one();
+    if (writer.joinable()) writer.join();
+
+    std::cout << "[BlackBox] " << capturesWritten.load() << " captures written ("
+              << bytesWritten.load() / 1024 << " KB), " << capturesSkipped.load() << " skipped\n";
+}
+
+void BlackBox::consume(const PipelineSample& sample) {
+    // Trigger on a rising trigger alert, the ring then holds the pre-trigger window
+    const uint32_t mask = toAlertMask(sample.alerts);
+    for (uint32_t rising = mask & ~lastMask & triggerMask; rising; rising &= rising - 1) {
+        startCapture(__builtin_ctz(rising), sample.time);
+    }
+    lastMask = mask;
+
+    ring[ringHead] = sample;
+    ringHead = (ringHead + 1) % ring.size();
+    if (ringCount < ring.size()) ++ringCount;
+
+    // Post-trigger window is [trigger, trigger + postSeconds)
+    for (Capture& capture : captures) {
+        if (capture.state != SlotState::Collecting) continue;
+        if (sample.time - capture.triggerTime >= postSeconds) {
+            finishCapture(capture);
+            continue;
+        }
+        capture.samples.push_back(sample);
+        if (capture.samples.size() == capture.samples.capacity()) finishCapture(capture);
+    }
+}
+
+void BlackBox::consumeBatch(const std::vector<PipelineSample>& batch) {
+    for (const PipelineSample& sample : batch) consume(sample);
+}
+
+/*-------------------------------------------------------------------------------------
+// Title: BlackBox::startCapture
+// Description:
+// Claim a free slot and copy the pre-trigger window out of the ring into it, oldest
+// first. The triggering sample is added by consume() as the first post-trigger
+// sample. Skipped when no slot is free or the disk cap could be exceeded, counting
+// every unwritten capture at its largest possible size.
+-------------------------------------------------------------------------------------*/
+void BlackBox::startCapture(int alert, double time) {
+    Capture* slot = nullptr;
+    uint64_t pendingBytes = 0; // Captures not yet on disk count against the cap too
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        for (Capture& capture : captures) {
+            if (capture.state == SlotState::Free) {
+                if (!slot) slot = &capture;
+            } else {
+                pendingBytes += capture.samples.capacity() * ESTIMATED_ROW_BYTES;
+            }
+        }
+    }
+    const uint64_t worstCase = slot ? slot->samples.capacity() * ESTIMATED_ROW_BYTES : 0;
+    if (!slot || bytesWritten.load(std::memory_order_relaxed) + pendingBytes + worstCase > maxDiskBytes) {
+        capturesSkipped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    slot->samples.clear();
+    slot->alert = alert;
+    slot->triggerTime = time;
+    slot->number = nextNumber++;
+    const std::size_t oldest = (ringHead + ring.size() - ringCount) % ring.size();
+    for (std::size_t i = 0; i < ringCount; ++i) {
+        const PipelineSample& sample = ring[(oldest + i) % ring.size()];
+        if (time - sample.time <= preSeconds) slot->samples.push_back(sample); // [trigger - preSeconds, trigger)
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+    slot->state = SlotState::Collecting;
+}// End of BlackBox::startCapture
+
+// Hand a complete capture to the writer thread
+void BlackBox::finishCapture(Capture& capture) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        capture.state = SlotState::Writing;
+    }
+    ready.notify_one();
+}
+
+// Writes captures as they complete, so file I/O never runs on the sink thread
+void BlackBox::writerLoop() {
+    std::unique_lock<std::mutex> lock(mutex);
+    for (;;) {
+        Capture* next = nullptr;
+        for (Capture& capture : captures) {
+            if (capture.state == SlotState::Writing && (!next || capture.number < next->number)) next = &capture;
+        }
+        if (!next) {
+            if (stopping) return;
+            ready.wait(lock);
+            continue;
+        }
+
+        lock.unlock();
+        writeCapture(*next);
+        lock.lock();
+        next->state = SlotState::Free;
+    }
+}
+
+/*-------------------------------------------------------------------------------------
+// Title: BlackBox::writeCapture
+// Description:
+// Format a capture into one buffer and write it with a single call. One row per
+// sample with every channel at full double precision, the offset from the trigger
+// and the alert mask.
+-------------------------------------------------------------------------------------*/
+void BlackBox::writeCapture(Capture& capture) {
+    std::string alertName = ALERT_NAMES[capture.alert];
+    for (char& c : alertName) if (c == ' ') c = '_';
+    char fileName[64];
+    std::snprintf(fileName, sizeof(fileName), "/event_%04llu_", (unsigned long long)capture.number);
+    const std::string path = directory + fileName + alertName + ".csv";
+
+    fileBuffer.clear();
+    fileBuffer += "# Trigger ";
+    fileBuffer += ALERT_NAMES[capture.alert];
+    char row[768];
+    int n = std::snprintf(row, sizeof(row), " at %.6f s, %.1f s before, %.1f s after\nSeconds,Offset,Seq",
+                          capture.triggerTime, preSeconds, postSeconds);
+    fileBuffer.append(row, n);
+    for (int c = 0; c < SENSOR_CHANNEL_COUNT; ++c) {
+        fileBuffer += ',';
+        fileBuffer += CHANNEL_IDENTIFIERS[c];
+    }
+    fileBuffer += ",AlertMask,Gap\n";
+
+    for (const PipelineSample& sample : capture.samples) {
+        const double* values = reinterpret_cast<const double*>(&sample.data);
+        n = std::snprintf(row, sizeof(row), "%.6f,%.6f,%llu", sample.time, sample.time - capture.triggerTime,
+                          (unsigned long long)sample.seq);
+        fileBuffer.append(row, n);
+        for (int c = 0; c < SENSOR_CHANNEL_COUNT; ++c) {
+            n = std::snprintf(row, sizeof(row), ",%.17g", values[c]);
+            fileBuffer.append(row, n);
+        }
+        n = std::snprintf(row, sizeof(row), ",%u,%d\n", toAlertMask(sample.alerts), sample.gap ? 1 : 0);
+        fileBuffer.append(row, n);
+    }
+
+    std::ofstream file(path, std::ios::out | std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) {
+        std::cerr << "[BlackBox] Error when trying to open " << path << std::endl;
+        return;
+    }
+    file.write(fileBuffer.data(), fileBuffer.size());
+    bytesWritten.fetch_add(fileBuffer.size(), std::memory_order_relaxed);
+    capturesWritten.fetch_add(1, std::memory_order_relaxed);
+}// End of BlackBox::writeCapture
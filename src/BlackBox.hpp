@@ -0,0 +1,74 @@
+#pragma once
+
+#include "Pipeline.hpp"
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Sink keeping the last preSeconds of full precision samples in a fixed ring. When one
+// of the trigger alerts rises, the ring is copied into a capture which keeps collecting
+// for postSeconds, then a writer thread saves it to <directory>/event_<n>_<ALERT>.csv.
+// All buffers are allocated up front: the ring holds preSeconds at MAX_RATE_HZ and each
+// of the MAX_CAPTURES slots holds pre plus post. A rise while every slot is busy, or
+// once maxDiskMB have been written, is counted and skipped.
+class BlackBox : public Sink {
+public:
+    static constexpr double MAX_RATE_HZ = 200.0; // Sample rate the windows are sized for
+    static constexpr int MAX_CAPTURES = 4;       // Collecting or waiting to be written
+
+    BlackBox(uint32_t triggerMask, double preSeconds, double postSeconds, std::size_t maxDiskMB,
+             const std::string& directory = "data/blackbox");
+    ~BlackBox(); // Writes captures still collecting, then stops the writer
+
+    const char* name() const override { return "black box"; }
+    void consume(const PipelineSample& sample) override;
+    void consumeBatch(const std::vector<PipelineSample>& batch) override;
+
+    uint64_t getCapturesWritten() const { return capturesWritten.load(std::memory_order_relaxed); }
+    uint64_t getCapturesSkipped() const { return capturesSkipped.load(std::memory_order_relaxed); }
+    uint64_t getBytesWritten() const { return bytesWritten.load(std::memory_order_relaxed); }
+
+private:
+    enum class SlotState { Free, Collecting, Writing };
+
+    struct Capture {
+        std::atomic<SlotState> state{SlotState::Free}; // Sink thread: Collecting, Writing. Writer: Free
+        int alert = 0;
+        double triggerTime = 0.0;
+        uint64_t number = 0;
+        std::vector<PipelineSample> samples; // Reserved up front, never grows
+    };
+
+    uint32_t triggerMask;
+    double preSeconds;
+    double postSeconds;
+    uint64_t maxDiskBytes;
+    std::string directory;
+
+    // Ring of the latest samples, sink thread only
+    std::vector<PipelineSample> ring;
+    std::size_t ringHead = 0;  // Next slot to write
+    std::size_t ringCount = 0;
+    uint32_t lastMask = 0;
+    uint64_t nextNumber = 0;
+
+    Capture captures[MAX_CAPTURES];
+    std::mutex mutex;
+    std::condition_variable ready; // A capture moved to Writing, or stopping
+    bool stopping = false;
+    std::thread writer;
+    std::string fileBuffer;        // Writer thread only, reused
+
+    std::atomic<uint64_t> capturesWritten{0};
+    std::atomic<uint64_t> capturesSkipped{0};
+    std::atomic<uint64_t> bytesWritten{0};
+
+    void startCapture(int alert, double time);
+    void finishCapture(Capture& capture);
+    void writerLoop();
+    void writeCapture(Capture& capture);
+};
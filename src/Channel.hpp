@@ -0,0 +1,168 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <iterator>
+#include <mutex>
+#include <vector>
+
+// What push() does when the channel is full
+enum class OverflowPolicy {
+    Block,      // Wait for the consumer (back-pressure)
+    DropOldest, // Discard the oldest item so the producer never waits
+    Grow        // Keep everything past capacity, the producer never waits and nothing is
+                // lost, memory grows while the consumer is behind
+};
+
+// Bounded multi-producer/multi-consumer queue connecting two pipeline stages
+// (unbounded with OverflowPolicy::Grow)
+template <typename T>
+class BoundedChannel {
+public:
+    explicit BoundedChannel(std::size_t capacity, OverflowPolicy policy = OverflowPolicy::Block)
+    : capacity(capacity), policy(policy) {}
+
+    // Add an item, returns false once the channel is closed
+    bool push(T item) {
+        {
+            std::unique_lock<std::mutex> lock(mtx);
+            if (policy == OverflowPolicy::Block) {
+                notFull.wait(lock, [this] { return items.size() < capacity || closed; });
+            }
+            if (closed) return false;
+            if (items.size() >= capacity && policy == OverflowPolicy::DropOldest) {
+                items.pop_front();
+                droppedCount.fetch_add(1, std::memory_order_relaxed);
+            }
+            items.push_back(std::move(item));
+            peak = std::max(peak, items.size());
+            pushedCount.fetch_add(1, std::memory_order_relaxed);
+            lastPushNs.store(nowNs(), std::memory_order_relaxed);
+        }
+        notEmpty.notify_one();
+        return true;
+    }
+
+    // Add a whole batch under one lock, returns false once the channel is closed
+    bool pushBatch(const std::vector<T>& batch) {
+        if (batch.empty()) return true;
+        {
+            std::unique_lock<std::mutex> lock(mtx);
+            for (const T& item : batch) {
+                // Let the consumer drain while we wait for room
+                while (policy == OverflowPolicy::Block && items.size() >= capacity && !closed) {
+                    notEmpty.notify_all();
+                    notFull.wait(lock);
+                }
+                if (closed) return false;
+                if (items.size() >= capacity && policy == OverflowPolicy::DropOldest) {
+                    items.pop_front();
+                    droppedCount.fetch_add(1, std::memory_order_relaxed);
+                }
+                items.push_back(item);
+            }
+            peak = std::max(peak, items.size());
+            pushedCount.fetch_add(batch.size(), std::memory_order_relaxed);
+            lastPushNs.store(nowNs(), std::memory_order_relaxed);
+        }
+        notEmpty.notify_one();
+        return true;
+    }
+
+    // Wait for at least one item, then linger up to maxWait for the batch to reach
+    // maxItems, and move up to maxItems out under a single lock. Returns false once
+    // the channel is closed and drained. waited is set as in pop()
+    bool popBatch(std::vector<T>& out, std::size_t maxItems, std::chrono::microseconds maxWait,
+                  bool* waited = nullptr) {
+        out.clear();
+        std::unique_lock<std::mutex> lock(mtx);
+        bool mustWait = items.empty() && !closed;
+        notEmpty.wait(lock, [this] { return !items.empty() || closed; });
+        if (items.empty()) return false;
+
+        // Trade a little latency for a fuller batch
+        if (maxWait.count() > 0 && items.size() < maxItems && !closed) {
+            notEmpty.wait_for(lock, maxWait, [&] { return items.size() >= maxItems || closed; });
+        }
+
+        std::size_t n = std::min(maxItems, items.size());
+        out.insert(out.end(), std::make_move_iterator(items.begin()),
+                   std::make_move_iterator(items.begin() + n));
+        items.erase(items.begin(), items.begin() + n);
+        lock.unlock();
+        notFull.notify_all();
+
+        if (waited) *waited = mustWait;
+        return true;
+    }
+
+    // Wait for an item, returns false once the channel is closed and drained.
+    // waited is set when the caller had to sleep for the item (used for jitter)
+    bool pop(T& item, bool* waited = nullptr) {
+        std::unique_lock<std::mutex> lock(mtx);
+        bool mustWait = items.empty() && !closed;
+        notEmpty.wait(lock, [this] { return !items.empty() || closed; });
+        if (items.empty()) return false;
+
+        item = std::move(items.front());
+        items.pop_front();
+        lock.unlock();
+        notFull.notify_one();
+
+        if (waited) *waited = mustWait;
+        return true;
+    }
+
+    // Wake everyone, further pushes fail and pops drain what is left
+    void close() {
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            closed = true;
+        }
+        notEmpty.notify_all();
+        notFull.notify_all();
+    }
+
+    std::size_t size() {
+        std::lock_guard<std::mutex> lock(mtx);
+        return items.size();
+    }
+    // Most items ever queued at once, above capacity only with OverflowPolicy::Grow
+    std::size_t peakSize() {
+        std::lock_guard<std::mutex> lock(mtx);
+        return peak;
+    }
+    std::size_t getCapacity() const { return capacity; }
+    uint64_t pushed() const { return pushedCount.load(std::memory_order_relaxed); }
+    uint64_t dropped() const { return droppedCount.load(std::memory_order_relaxed); }
+
+    // Seconds since the most recent push, steady clock
+    double sinceLastPush() const {
+        return (nowNs() - lastPushNs.load(std::memory_order_relaxed)) / 1e9;
+    }
+
+private:
+    static int64_t nowNs() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    const std::size_t capacity;
+    const OverflowPolicy policy;
+
+    std::mutex mtx;
+    std::condition_variable notEmpty;
+    std::condition_variable notFull;
+    std::deque<T> items;
+    std::size_t peak = 0;
+    bool closed = false;
+
+    std::atomic<uint64_t> pushedCount{0};
+    std::atomic<uint64_t> droppedCount{0};
+    std::atomic<int64_t> lastPushNs{0};
+};
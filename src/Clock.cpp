@@ -0,0 +1,48 @@
+#include "Clock.hpp"
+#include <cmath>
+#include <ctime>
+#include <thread>
+
+std::string Clock::iso8601(double time) const {
+    std::time_t seconds = (std::time_t)std::floor(epoch + time);
+    std::tm utc_tm = *std::gmtime(&seconds);
+
+    char text[32];
+    std::size_t n = std::strftime(text, sizeof(text), "%Y-%m-%dT%H:%M:%SZ", &utc_tm);
+    return std::string(text, n);
+}
+
+// Constructor, epoch is the wall time now
+RealClock::RealClock()
+: Clock(std::chrono::duration<double>(std::chrono::system_clock::now().time_since_epoch()).count()),
+  start(std::chrono::steady_clock::now()) {}
+
+double RealClock::now() {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+void RealClock::sleepUntil(double time) {
+    std::this_thread::sleep_until(start + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                                              std::chrono::duration<double>(time)));
+}
+
+double ScaledClock::now() {
+    return RealClock::now() * scale;
+}
+
+void ScaledClock::sleepUntil(double time) {
+    RealClock::sleepUntil(time / scale);
+}
+
+// Jump straight to time, never backwards
+void VirtualClock::sleepUntil(double time) {
+    if (time > current.load(std::memory_order_relaxed)) current.store(time, std::memory_order_release);
+}
+
+std::unique_ptr<Clock> makeClock(ClockMode mode, double scale) {
+    switch (mode) {
+        case ClockMode::Scaled: return std::make_unique<ScaledClock>(scale);
+        case ClockMode::Virtual: return std::make_unique<VirtualClock>();
+        default: return std::make_unique<RealClock>();
+    }
+}
@@ -0,0 +1,84 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <string>
+
+// How pipeline time advances (--clock)
+enum class ClockMode {
+    Real,    // Wall clock
+    Scaled,  // Wall clock sped up (or slowed down) by a factor
+    Virtual  // Only moves when the source sleeps, sleeping returns at once
+};
+
+// Source of pipeline time. Every sample is stamped with now() at ingest and every
+// time downstream (alert durations, "for" holds, plots, summary, log timestamps) is
+// derived from that stamp, so swapping the clock changes how fast the whole run goes
+// without touching any stage. Time is seconds since the clock was created.
+class Clock {
+public:
+    virtual ~Clock() = default;
+
+    // Seconds of pipeline time since the clock started
+    virtual double now() = 0;
+
+    // Block until now() >= time, returns at once when already past it
+    virtual void sleepUntil(double time) = 0;
+
+    virtual const char* name() const = 0;
+
+    // UTC wall time of pipeline time 0, seconds since 1970
+    double getEpoch() const { return epoch; }
+
+    // ISO 8601 UTC timestamp of a pipeline time, e.g. "2025-07-04T13:47:37Z"
+    std::string iso8601(double time) const;
+
+protected:
+    explicit Clock(double epoch) : epoch(epoch) {}
+    double epoch;
+};
+
+// Wall clock, sleeps really sleep
+class RealClock : public Clock {
+public:
+    RealClock();
+    double now() override;
+    void sleepUntil(double time) override;
+    const char* name() const override { return "real"; }
+
+protected:
+    std::chrono::steady_clock::time_point start;
+};
+
+// Wall clock running scale times faster, a 500 ms period sleeps 500/scale ms
+class ScaledClock : public RealClock {
+public:
+    explicit ScaledClock(double scale) : scale(scale) {}
+    double now() override;
+    void sleepUntil(double time) override;
+    const char* name() const override { return "scaled"; }
+    double getScale() const { return scale; }
+
+private:
+    double scale;
+};
+
+// Stepped clock: time only moves when the source sleeps, and the sleep returns at
+// once, so a run goes as fast as the pipeline can process it. Starts at a fixed
+// epoch so log timestamps are the same on every run.
+class VirtualClock : public Clock {
+public:
+    static constexpr double DEFAULT_EPOCH = 946684800.0; // 2000-01-01T00:00:00Z
+
+    explicit VirtualClock(double epoch = DEFAULT_EPOCH) : Clock(epoch) {}
+    double now() override { return current.load(std::memory_order_acquire); }
+    void sleepUntil(double time) override;
+    const char* name() const override { return "virtual"; }
+
+private:
+    std::atomic<double> current{0.0}; // Written by the source thread only
+};
+
+// Clock for the --clock option, scale is only used by ClockMode::Scaled
+std::unique_ptr<Clock> makeClock(ClockMode mode, double scale);
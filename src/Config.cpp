@@ -0,0 +1,317 @@
+#include "Config.hpp"
+#include "SensorData.hpp"
+#include "AlertFlags.hpp"
+#include <cctype>
+#include <iostream>
+#include <sstream>
+
+// Returns true and sets value if arg looks like "<name>=<value>"
+static bool matchOption(const std::string& arg, const std::string& name, std::string& value) {
+    std::string prefix = name + "=";
+    if (arg.rfind(prefix, 0) != 0) return false;
+    value = arg.substr(prefix.size());
+    return true;
+}
+
+// Look up a thread role by its command line name
+static bool parseRole(const std::string& name, ThreadRole& role) {
+    for (int i = 0; i < THREAD_ROLE_COUNT; ++i) {
+        if (name == threadRoleName(static_cast<ThreadRole>(i))) {
+            role = static_cast<ThreadRole>(i);
+            return true;
+        }
+    }
+    std::cerr << "Unknown thread '" << name << "'. Use ingest, analyze, logger or gui" << std::endl;
+    return false;
+}
+
+// Turn a CPU list like "2,3" into an affinity mask
+static uint64_t parseCpuList(const std::string& list) {
+    uint64_t mask = 0;
+    std::istringstream stream(list);
+    std::string cpu;
+    while (std::getline(stream, cpu, ',')) {
+        int n = std::stoi(cpu);
+        if (n < 0 || n > 63) throw std::out_of_range("cpu index must be 0-63");
+        mask |= (uint64_t)1 << n;
+    }
+    return mask;
+}
+
+// Turn a channel list like "throttle,fuelCap" into a SensorChannel bitmask
+static bool parseChannelList(const std::string& list, uint32_t& mask) {
+    std::istringstream stream(list);
+    std::string name;
+    while (std::getline(stream, name, ',')) {
+        int channel = 0;
+        while (channel < SENSOR_CHANNEL_COUNT && name != CHANNEL_IDENTIFIERS[channel]) ++channel;
+        if (channel == SENSOR_CHANNEL_COUNT) {
+            std::cerr << "Unknown channel '" << name << "'. Use SensorData field names, e.g. throttle" << std::endl;
+            return false;
+        }
+        mask |= 1u << channel;
+    }
+    return true;
+}
+
+// Turn "LOW_OIL_PRESSURE,STALL_SPEED" (ALERT_NAMES, any case, _ for spaces) or "all" into a toAlertMask mask
+static bool parseAlertList(const std::string& list, uint32_t& mask) {
+    std::istringstream stream(list);
+    std::string name;
+    while (std::getline(stream, name, ',')) {
+        for (char& c : name) c = (c == '_') ? ' ' : (char)std::toupper((unsigned char)c);
+        if (name == "ALL") {
+            mask |= (1u << ALERT_COUNT) - 1;
+            continue;
+        }
+        int alert = 0;
+        while (alert < ALERT_COUNT && name != ALERT_NAMES[alert]) ++alert;
+        if (alert == ALERT_COUNT) {
+            std::cerr << "Unknown alert '" << name << "'. Use names like LOW_OIL_PRESSURE or all" << std::endl;
+            return false;
+        }
+        mask |= 1u << alert;
+    }
+    return true;
+}
+
+void printUsage(const char* program) {
+    std::cerr << "Usage: " << program << " [random|flightgear] [options]\n"
+              << "Options:\n"
+              << "  --protocol=text|binary   FlightGear wire format (sensor.xml or sensor_bin.xml)\n"
+              << "  --port=<n>               UDP port to listen on for FlightGear (default 5500)\n"
+              << "  --max-fps=<hz>           GUI redraw cap while focused (default 60)\n"
+              << "  --min-fps=<hz>           GUI idle redraw floor (default 1)\n"
+              << "  --unfocused-fps=<hz>     GUI redraw cap while unfocused (default 5)\n"
+              << "  --binary-log[=full|compact] Also write samples to data/sensor_log.bin (default full)\n"
+              << "  --resample=<hz>          Resample onto a uniform time grid before evaluation\n"
+              << "  --resample-gap=<s>       Longest input gap interpolated across (default 1)\n"
+              << "  --resample-hold=<list>   Channels held instead of interpolated, e.g. throttle,fuelCap\n"
+              << "  --rules=<file>           Evaluate alerts from a rules file, e.g. --rules=src/alert_rules.txt\n"
+              << "  --blackbox=<alerts>      Capture samples around rising alerts, e.g. --blackbox=LOW_OIL_PRESSURE,PITCH or all\n"
+              << "  --blackbox-pre=<s>       Seconds kept before the trigger (default 30)\n"
+              << "  --blackbox-post=<s>      Seconds captured after the trigger (default 10)\n"
+              << "  --blackbox-max-mb=<MB>   Stop capturing after this much disk use (default 100)\n"
+              << "  --publish=<ip>:<port>    Rebroadcast evaluated samples over UDP, e.g. --publish=239.255.0.172:6000\n"
+              << "  --publish-ttl=<n>        Multicast TTL for --publish (default 1)\n"
+              << "  --channel-capacity=<n>   Samples per channel before it blocks, drops or grows (default 4096)\n"
+              << "  --lossless               Sinks that drop when behind block instead\n"
+              << "  --max-batch=<n>          Most samples a stage processes at once (default 256)\n"
+              << "  --max-batch-latency-ms=<ms> Time the analyzer may wait to fill a batch (default 0)\n"
+              << "  --reactor                Receive, evaluate and log on one thread (flightgear mode)\n"
+              << "  --clock=real|virtual|<x> Time source for random mode, <x> runs x times faster (default real)\n"
+              << "  --seed=<n>               Random generator seed, random mode (default random, printed)\n"
+              << "  --duration=<s>           Stop generating after s seconds of clock time, random mode\n"
+              << "  --headless               No window, exit once the source stops\n"
+              << "  --cpu-<thread>=<list>    Pin ingest|analyze|logger|gui threads to CPUs, e.g. --cpu-ingest=2,3\n"
+              << "  --rt=<thread>[,...]      Run threads at time-critical priority, e.g. --rt=ingest,analyze\n"
+              << "  --lock-memory=<MB>       Keep MB of the process resident\n";
+}
+
+/*-------------------------------------------------------------------------------------
+// Title: parseConfig
+// Description:
+// Parse the command line into a PipelineConfig. The first argument is the mode,
+// every argument after it is an optional "--name=value" pair. Prints an error and
+// returns false on anything it does not understand.
+-------------------------------------------------------------------------------------*/
+bool parseConfig(int argc, char* argv[], PipelineConfig& config) {
+    // Mode is required
+    if (argc < 2) {
+        printUsage(argv[0]);
+        return false;
+    }
+
+    config.mode = argv[1];
+    if (config.mode != "random" && config.mode != "flightgear") {
+        std::cerr << "Invalid mode. Use 'flightgear' or 'random'" << std::endl;
+        return false;
+    }
+
+    for (int i = 2; i < argc; ++i) {
+        std::string arg = argv[i];
+        std::string value;
+
+        try {
+            if (matchOption(arg, "--protocol", value)) {
+                if (value == "text") config.fgFormat = FGFormat::Text;
+                else if (value == "binary") config.fgFormat = FGFormat::Binary;
+                else {
+                    std::cerr << "Invalid protocol '" << value << "'. Use 'text' or 'binary'" << std::endl;
+                    return false;
+                }
+            }
+            else if (matchOption(arg, "--port", value)) {
+                config.port = std::stoi(value);
+            }
+            else if (matchOption(arg, "--max-fps", value)) {
+                config.maxFps = std::stod(value);
+            }
+            else if (matchOption(arg, "--min-fps", value)) {
+                config.minFps = std::stod(value);
+            }
+            else if (matchOption(arg, "--unfocused-fps", value)) {
+                config.unfocusedFps = std::stod(value);
+            }
+            else if (arg == "--binary-log") {
+                config.binaryLog = BinaryLogFormat::Full;
+            }
+            else if (matchOption(arg, "--binary-log", value)) {
+                if (value == "full") config.binaryLog = BinaryLogFormat::Full;
+                else if (value == "compact") config.binaryLog = BinaryLogFormat::Compact;
+                else {
+                    std::cerr << "Invalid binary log format '" << value << "'. Use 'full' or 'compact'" << std::endl;
+                    return false;
+                }
+            }
+            else if (matchOption(arg, "--resample", value)) {
+                config.resampleHz = std::stod(value);
+            }
+            else if (matchOption(arg, "--resample-gap", value)) {
+                config.resampleGap = std::stod(value);
+            }
+            else if (matchOption(arg, "--resample-hold", value)) {
+                if (!parseChannelList(value, config.resampleHoldMask)) return false;
+            }
+            else if (matchOption(arg, "--rules", value)) {
+                config.rulesFile = value;
+            }
+            else if (matchOption(arg, "--blackbox", value)) {
+                if (!parseAlertList(value, config.blackboxMask)) return false;
+            }
+            else if (matchOption(arg, "--blackbox-pre", value)) {
+                config.blackboxPre = std::stod(value);
+            }
+            else if (matchOption(arg, "--blackbox-post", value)) {
+                config.blackboxPost = std::stod(value);
+            }
+            else if (matchOption(arg, "--blackbox-max-mb", value)) {
+                config.blackboxMaxMB = std::stoul(value);
+            }
+            else if (matchOption(arg, "--publish", value)) {
+                std::size_t colon = value.rfind(':');
+                if (colon == std::string::npos || colon == 0) {
+                    std::cerr << "Invalid publish target '" << value << "'. Use <ip>:<port>" << std::endl;
+                    return false;
+                }
+                config.publishAddress = value.substr(0, colon);
+                config.publishPort = std::stoi(value.substr(colon + 1));
+            }
+            else if (matchOption(arg, "--publish-ttl", value)) {
+                config.publishTtl = std::stoi(value);
+            }
+            else if (matchOption(arg, "--channel-capacity", value)) {
+                config.channelCapacity = std::stoul(value);
+            }
+            else if (arg == "--lossless") {
+                config.lossless = true;
+            }
+            else if (matchOption(arg, "--max-batch", value)) {
+                config.maxBatch = std::stoul(value);
+            }
+            else if (matchOption(arg, "--max-batch-latency-ms", value)) {
+                config.maxBatchLatencyMs = std::stod(value);
+            }
+            else if (arg == "--reactor") {
+                config.reactor = true;
+            }
+            else if (matchOption(arg, "--clock", value)) {
+                if (value == "real") config.clockMode = ClockMode::Real;
+                else if (value == "virtual") config.clockMode = ClockMode::Virtual;
+                else {
+                    config.clockMode = ClockMode::Scaled;
+                    config.clockScale = std::stod(value);
+                }
+            }
+            else if (matchOption(arg, "--seed", value)) {
+                config.seed = (uint32_t)std::stoul(value);
+                config.hasSeed = true;
+            }
+            else if (matchOption(arg, "--duration", value)) {
+                config.duration = std::stod(value);
+            }
+            else if (arg == "--headless") {
+                config.headless = true;
+            }
+            else if (arg.rfind("--cpu-", 0) == 0 && arg.find('=') != std::string::npos) {
+                ThreadRole role;
+                std::size_t eq = arg.find('=');
+                if (!parseRole(arg.substr(6, eq - 6), role)) return false;
+                config.threads[static_cast<int>(role)].affinityMask = parseCpuList(arg.substr(eq + 1));
+            }
+            else if (matchOption(arg, "--rt", value)) {
+                std::istringstream stream(value);
+                std::string name;
+                while (std::getline(stream, name, ',')) {
+                    ThreadRole role;
+                    if (!parseRole(name, role)) return false;
+                    config.threads[static_cast<int>(role)].realtime = true;
+                }
+            }
+            else if (matchOption(arg, "--lock-memory", value)) {
+                config.lockMemoryMB = std::stoul(value);
+            }
+            else {
+                std::cerr << "Unknown option: " << arg << std::endl;
+                printUsage(argv[0]);
+                return false;
+            }
+        } catch (const std::exception& e) {
+            std::cerr << "Bad value for option " << arg << " (" << e.what() << ")" << std::endl;
+            return false;
+        }
+    }
+
+    if (config.channelCapacity == 0 || config.maxBatch == 0 || config.maxBatchLatencyMs < 0.0) {
+        std::cerr << "--channel-capacity and --max-batch must be at least 1, latency not negative" << std::endl;
+        return false;
+    }
+
+    if (config.reactor && config.mode != "flightgear") {
+        std::cerr << "--reactor only applies to flightgear mode" << std::endl;
+        return false;
+    }
+
+    // FlightGear streams in real time, only the generator can run on another clock
+    if ((config.clockMode != ClockMode::Real || config.hasSeed || config.duration != 0.0) &&
+        config.mode != "random") {
+        std::cerr << "--clock, --seed and --duration only apply to random mode" << std::endl;
+        return false;
+    }
+    if ((config.clockMode == ClockMode::Scaled && config.clockScale <= 0.0) || config.duration < 0.0) {
+        std::cerr << "--clock speed-up must be positive and --duration not negative" << std::endl;
+        return false;
+    }
+    if (config.clockMode == ClockMode::Virtual) {
+        if (config.duration == 0.0) {
+            std::cerr << "--clock=virtual runs as fast as possible and needs a --duration" << std::endl;
+            return false;
+        }
+        config.lossless = true; // A drop would depend on thread timing and change the logs
+    }
+
+    if (config.resampleHz < 0.0 || config.resampleGap <= 0.0) {
+        std::cerr << "--resample must not be negative and --resample-gap must be positive" << std::endl;
+        return false;
+    }
+
+    if (config.blackboxPre < 0.0 || config.blackboxPost < 0.0 || config.blackboxPre + config.blackboxPost > 600.0) {
+        std::cerr << "--blackbox-pre and --blackbox-post must not be negative or add up to more than 600 s" << std::endl;
+        return false;
+    }
+
+    if (!config.publishAddress.empty() && (config.publishPort <= 0 || config.publishPort > 65535 ||
+        config.publishTtl < 0 || config.publishTtl > 255)) {
+        std::cerr << "--publish port must be 1-65535 and --publish-ttl 0-255" << std::endl;
+        return false;
+    }
+
+    // Frame rates are used as divisors
+    if (config.maxFps <= 0.0 || config.minFps <= 0.0 || config.unfocusedFps <= 0.0 ||
+        config.minFps > config.maxFps) {
+        std::cerr << "Frame rates must be positive and --min-fps <= --max-fps" << std::endl;
+        return false;
+    }
+
+    return true;
+}// End of parseConfig
\ No newline at end of file
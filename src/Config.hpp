@@ -0,0 +1,71 @@
+#pragma once
+
+#include "ThreadControl.hpp"
+#include "Clock.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// Wire format of the FlightGear generic protocol stream
+enum class FGFormat {
+    Text,   // sensor.xml: tab separated "KEY=value" ASCII lines
+    Binary  // sensor_bin.xml: fixed layout network-order floats + magic footer
+};
+
+// Record layout of data/sensor_log.bin
+enum class BinaryLogFormat {
+    Off,
+    Full,   // BinaryLogRecord, 160 bytes, full double precision
+    Compact // PackedSample, 56 bytes, 0.01 resolution (see PackedSample.hpp)
+};
+
+// Runtime options for the pipeline, filled in from the command line
+struct PipelineConfig {
+    std::string mode;                  // "random" or "flightgear"
+    FGFormat fgFormat = FGFormat::Text; // Format FlightGear was started with
+    int port = 5500;                   // UDP port FlightGear streams to
+
+    // GUI frame pacing, the window only redraws on new data, input or alert changes
+    double maxFps = 60.0;              // Upper bound on redraw rate while focused
+    double minFps = 1.0;               // Redraw at least this often even when idle
+    double unfocusedFps = 5.0;         // Upper bound while unfocused (low-power mode)
+
+    // Stage graph
+    std::size_t channelCapacity = 4096; // Samples buffered per channel before dropping oldest
+    bool lossless = false;             // Dropping sinks block instead (the CSV sink never drops)
+    std::size_t maxBatch = 256;        // Most samples a stage takes from its channel at once
+    double maxBatchLatencyMs = 0.0;    // How long the analyzer may wait to fill a batch (0 = never)
+    bool reactor = false;              // FlightGear only: one thread receives, evaluates and logs
+    BinaryLogFormat binaryLog = BinaryLogFormat::Off; // Also write data/sensor_log.bin
+    double resampleHz = 0.0;           // Uniform output rate, 0 = pass samples through as they arrive
+    double resampleGap = 1.0;          // Longest input interval (s) interpolated across
+    uint32_t resampleHoldMask = 0;     // Bit per SensorChannel held instead of interpolated
+    std::string rulesFile;             // Alert rules to compile instead of AlertManager (see AlertRules.hpp)
+    uint32_t blackboxMask = 0;         // Alerts (toAlertMask bits) that trigger a black box capture, 0 = off
+    double blackboxPre = 30.0;         // Seconds kept before the trigger
+    double blackboxPost = 10.0;        // Seconds captured after it
+    std::size_t blackboxMaxMB = 100;   // Stop capturing once this much is on disk
+
+    // Time source and run length, random mode only (see Clock.hpp)
+    ClockMode clockMode = ClockMode::Real;
+    double clockScale = 1.0;           // ClockMode::Scaled speed-up
+    bool hasSeed = false;
+    uint32_t seed = 0;                 // Random generator seed when hasSeed
+    double duration = 0.0;             // Seconds of clock time to generate, 0 = until stopped
+    bool headless = false;             // No window, exit when the source stops
+
+    // UDP rebroadcast of evaluated samples, off when publishAddress is empty
+    std::string publishAddress;        // IPv4 unicast address or multicast group
+    int publishPort = 0;
+    int publishTtl = 1;                // Multicast hops, 1 = local network only
+
+    // Thread placement, indexed by ThreadRole
+    ThreadSettings threads[THREAD_ROLE_COUNT];
+    std::size_t lockMemoryMB = 0;      // 0 = don't lock
+};
+
+// Parse "<program> <mode> [--option=value ...]" into config, returns false on bad input
+bool parseConfig(int argc, char* argv[], PipelineConfig& config);
+
+// Print command line usage to stderr
+void printUsage(const char* program);
\ No newline at end of file
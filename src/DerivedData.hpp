@@ -0,0 +1,30 @@
+#pragma once
+
+#include <cstddef>
+
+// Flight metrics computed from SensorData by the analyze stage (see DerivedMetrics)
+struct DerivedData {
+    double densityAltitude;  // Density altitude in feet
+    double endurance;        // Minutes of fuel left at the current fuel flow
+    double range;            // Nautical miles of fuel left at the current speed (no wind)
+    double climbGradient;    // Climb gradient in percent, feet up per 100 feet forward
+    double loadFactor;       // Load factor in g of a level coordinated turn at the current roll
+};
+
+// Index of each DerivedData field when the struct is read as an array of doubles
+enum DerivedChannel {
+    DC_DENSITY_ALTITUDE, DC_ENDURANCE, DC_RANGE, DC_CLIMB_GRADIENT, DC_LOAD_FACTOR,
+    DERIVED_CHANNEL_COUNT
+};
+static_assert(sizeof(DerivedData) == DERIVED_CHANNEL_COUNT * sizeof(double), "DerivedData must be plain doubles");
+static_assert(offsetof(DerivedData, loadFactor) == DC_LOAD_FACTOR * sizeof(double), "DerivedChannel order must match DerivedData");
+
+// Log names for each derived metric, index is the DerivedChannel
+inline const char* const DERIVED_NAMES[DERIVED_CHANNEL_COUNT] = {
+    "DENSITY ALTITUDE", "ENDURANCE", "RANGE", "CLIMB GRADIENT", "LOAD FACTOR"
+};
+
+// Field name of each derived metric as typed in rule files
+inline const char* const DERIVED_IDENTIFIERS[DERIVED_CHANNEL_COUNT] = {
+    "densityAltitude", "endurance", "range", "climbGradient", "loadFactor"
+};
@@ -0,0 +1,39 @@
+#include "DerivedMetrics.hpp"
+#include <algorithm>
+#include <cmath>
+
+/*-------------------------------------------------------------------------------------
+// Title: DerivedMetrics::compute
+// Description:
+// Straight-line arithmetic with no branches, each metric only needs the sample itself
+// so the batch form is one pass with no state between samples.
+//  density altitude = altitude + 118.8 ft * (OAT - ISA temperature at that altitude)
+//  endurance        = fuel / fuel flow, in minutes
+//  range            = endurance * speed, in nautical miles
+//  climb gradient   = vertical speed / forward speed, in percent
+//  load factor      = 1 / cos(roll), a level coordinated turn
+-------------------------------------------------------------------------------------*/
+DerivedData DerivedMetrics::compute(const SensorData& data) {
+    using namespace DerivedConstants;
+    DerivedData derived;
+
+    const double oatC = (data.temperature - 32.0) * (5.0 / 9.0);
+    const double isaC = ISA_SEA_LEVEL_C - ISA_LAPSE_C_PER_FT * data.altitude;
+    derived.densityAltitude = data.altitude + DA_FT_PER_C * (oatC - isaC);
+
+    const double hours = std::max(data.fuelCap, 0.0) / std::max(data.fuelFlow, MIN_FUEL_FLOW);
+    derived.endurance = hours * 60.0;
+    derived.range = hours * std::max(data.speed, 0.0);
+
+    derived.climbGradient = 100.0 * data.verticalSpeed / (std::max(data.speed, MIN_SPEED) * FT_PER_MIN_PER_KT);
+
+    const double roll = data.roll * DEG_TO_RAD;
+    derived.loadFactor = 1.0 / std::max(std::cos(roll), MIN_COS_ROLL);
+    return derived;
+}// End of DerivedMetrics::compute
+
+void DerivedMetrics::compute(PipelineSample* samples, std::size_t count) {
+    for (std::size_t i = 0; i < count; ++i) {
+        samples[i].derived = compute(samples[i].data);
+    }
+}
@@ -0,0 +1,33 @@
+#pragma once
+
+#include "SensorData.hpp"
+#include "DerivedData.hpp"
+#include "PipelineSample.hpp"
+#include <cstddef>
+
+// Constants of the derived metrics, rules of thumb for a piston single
+namespace DerivedConstants {
+    static constexpr double ISA_SEA_LEVEL_C = 15.0;     // Standard temperature at sea level
+    static constexpr double ISA_LAPSE_C_PER_FT = 0.00198; // Standard lapse rate, 1.98 C per 1000 ft
+    static constexpr double DA_FT_PER_C = 118.8;        // Density altitude change per degree off standard
+    static constexpr double MIN_FUEL_FLOW = 0.1;        // gph, below this endurance is capped instead of dividing by ~0
+    static constexpr double MIN_SPEED = 1.0;            // kt, same for the climb gradient
+    static constexpr double FT_PER_MIN_PER_KT = 101.269; // 1 kt in ft/min
+    static constexpr double DEG_TO_RAD = 3.14159265358979323846 / 180.0;
+    static constexpr double MIN_COS_ROLL = 0.1;         // Caps the load factor at 10 g past ~84 degrees of roll
+};// DerivedConstants
+
+// Derived-metrics stage: density altitude, fuel endurance and range, climb gradient
+// and load factor from fields SensorData already has. Runs in the analyze stage
+// after resampling and before alert evaluation, so AlertManager, --rules and every
+// sink read the values from PipelineSample::derived instead of computing them again.
+// Pressure altitude is taken as the indicated altitude and ground speed as the
+// airspeed, since neither the altimeter setting nor the wind is streamed.
+class DerivedMetrics {
+public:
+    // Derived metrics of one sample
+    static DerivedData compute(const SensorData& data);
+
+    // Batch form used by the analyze stage, fills in each sample's derived metrics
+    static void compute(PipelineSample* samples, std::size_t count);
+};
@@ -0,0 +1,145 @@
+#include "FGDecoder.hpp"
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <iostream>
+#include <sstream>
+#include <utility>
+#include <vector>
+
+// Read a big-endian (network order) 32 bit word without relying on winsock's ntohl
+static uint32_t readBE32(const unsigned char* p) {
+    return (uint32_t(p[0]) << 24) | (uint32_t(p[1]) << 16) | (uint32_t(p[2]) << 8) | uint32_t(p[3]);
+}
+
+static float readBEFloat(const unsigned char* p) {
+    uint32_t bits = readBE32(p);
+    float value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+/*-------------------------------------------------------------------------------------
+// Title: FGDecoder::parseText
+// Description:
+// Parse a line of FlightGear data and extract sensor values.
+// This function takes a line of data from FlightGear, splits it by tabs, and extracts
+// the sensor values into a SensorData structure. It returns true if parsing is successful,
+// or false if the line is malformed.
+-------------------------------------------------------------------------------------*/
+bool FGDecoder::parseText(const std::string& line, SensorData& data, StreamStamp* stamp) {
+    bool parsed = false;             // Initialize parsed flag to false
+    std::istringstream stream(line); // Create a string stream from the line
+    std::string token;               // Variable to hold each token
+
+    // Define handlers for each prefix. The table is static so the target struct is
+    // passed in rather than captured (a captured reference would outlive the first call)
+    using Handler = std::function<void(SensorData&, const std::string&)>;
+    static const std::vector<std::pair<std::string, Handler>> handlers = {
+        {"TF=", [](SensorData& d, const std::string& val) { d.temperature = std::stof(val); }},
+        {"A=",  [](SensorData& d, const std::string& val) { d.altitude = std::stof(val); }},
+        {"AGL=", [](SensorData& d, const std::string& val) { d.agl = std::stof(val); }},
+        {"V=",  [](SensorData& d, const std::string& val) { d.speed = std::stof(val); }},
+        {"VSF=", [](SensorData& d, const std::string& val) { d.verticalSpeed = std::stof(val) * 60; }},
+        {"ER=", [](SensorData& d, const std::string& val) { d.engineRPM = std::stof(val); }},
+        {"T=",  [](SensorData& d, const std::string& val) { d.throttle = std::stof(val); }},
+        {"OP=", [](SensorData& d, const std::string& val) { d.oilPressure = std::stof(val); }},
+        {"OT=", [](SensorData& d, const std::string& val) { d.oilTemperature = std::stof(val); }},
+        {"FCG=", [](SensorData& d, const std::string& val) { d.fuelCap = std::stof(val); }},
+        {"FFG=", [](SensorData& d, const std::string& val) { d.fuelFlow = std::stof(val); }},
+        {"PA=", [](SensorData& d, const std::string& val) { d.pitch = std::stof(val); }},
+        {"PR=", [](SensorData& d, const std::string& val) { d.pitchRate = std::stof(val); }},
+        {"RA=", [](SensorData& d, const std::string& val) { d.roll = std::stof(val); }},
+        {"RR=", [](SensorData& d, const std::string& val) { d.rollRate = std::stof(val); }},
+        {"YA=", [](SensorData& d, const std::string& val) { d.yaw = std::stof(val); }},
+        {"YR=", [](SensorData& d, const std::string& val) { d.yawRate = std::stof(val); }},
+    };
+
+    while (stream >> token) {
+        // Sender stamp, malformed values are just left out
+        if (stamp && token.rfind("SEQ=", 0) == 0) {
+            char* end = nullptr;
+            unsigned long long seq = std::strtoull(token.c_str() + 4, &end, 10);
+            if (end && *end == '\0' && end != token.c_str() + 4) {
+                stamp->seq = seq;
+                stamp->hasSeq = true;
+            }
+            continue;
+        }
+        if (stamp && token.rfind("ST=", 0) == 0) {
+            char* end = nullptr;
+            double simTime = std::strtod(token.c_str() + 3, &end);
+            if (end && *end == '\0' && end != token.c_str() + 3) {
+                stamp->simTime = simTime;
+                stamp->hasTime = true;
+            }
+            continue;
+        }
+
+        for (const auto& [prefix, handler] : handlers) {
+            if (token.rfind(prefix, 0) == 0) {
+                try {
+                    handler(data, token.substr(prefix.size()));
+                    parsed = true;
+                } catch (const std::exception& e) {
+                    std::cerr << "Failed to parse token: " << token << " (" << e.what() << ")\n";
+                }
+                break;
+            }
+        }
+    }
+    
+    // If any of the expected fields were parsed, return true
+    return parsed;
+}// End of parseText
+
+/*-------------------------------------------------------------------------------------
+// Title: FGDecoder::parseBinary
+// Description:
+// Decode one binary datagram sent with sensor_bin.xml. FlightGear writes every chunk
+// as a 4 byte float in network byte order, in chunk order, then the magic footer.
+// The datagram is rejected unless it is BINARY_PACKET_SIZE bytes (or
+// BINARY_STAMPED_PACKET_SIZE with the sim time chunk) and ends with BINARY_MAGIC,
+// so a text stream or a different protocol file is never decoded.
+-------------------------------------------------------------------------------------*/
+bool FGDecoder::parseBinary(const char* buffer, std::size_t length, SensorData& data, StreamStamp* stamp) {
+    // Length check, every field is always present in the binary layout
+    if (length != BINARY_PACKET_SIZE && length != BINARY_STAMPED_PACKET_SIZE) return false;
+
+    const unsigned char* p = reinterpret_cast<const unsigned char*>(buffer);
+
+    // Footer check
+    if (readBE32(p + length - sizeof(uint32_t)) != BINARY_MAGIC) return false;
+
+    // Sim time chunk sits between the fields and the footer
+    if (stamp && length == BINARY_STAMPED_PACKET_SIZE) {
+        stamp->simTime = readBEFloat(p + BINARY_FIELD_COUNT * sizeof(float));
+        stamp->hasTime = true;
+    }
+
+    // Decode fields straight out of the receive buffer
+    float v[BINARY_FIELD_COUNT];
+    for (std::size_t i = 0; i < BINARY_FIELD_COUNT; ++i) {
+        v[i] = readBEFloat(p + i * sizeof(float));
+    }
+
+    data.temperature    = v[0];
+    data.altitude       = v[1];
+    data.agl            = v[2];
+    data.speed          = v[3];
+    data.verticalSpeed  = v[4] * 60; // fps -> fpm, same as the text path
+    data.engineRPM      = v[5];
+    data.throttle       = v[6];
+    data.oilPressure    = v[7];
+    data.oilTemperature = v[8];
+    data.fuelCap        = v[9];
+    data.fuelFlow       = v[10];
+    data.pitch          = v[11];
+    data.pitchRate      = v[12];
+    data.roll           = v[13];
+    data.rollRate       = v[14];
+    data.yaw            = v[15];
+    data.yawRate        = v[16];
+
+    return true;
+}// End of parseBinary
\ No newline at end of file
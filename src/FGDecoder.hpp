@@ -0,0 +1,34 @@
+#pragma once
+
+#include "SensorData.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// Optional sender stamp of a datagram, used for stream health tracking
+struct StreamStamp {
+    bool hasSeq = false;
+    uint64_t seq = 0;       // Packet counter ("SEQ=", text only)
+    bool hasTime = false;
+    double simTime = 0.0;   // Sender clock in seconds ("ST=", FlightGear /sim/time/elapsed-sec)
+};
+
+// Decoders for the two FlightGear generic protocol formats
+// sensor.xml     -> text lines of "TF=%.6lf<tab>A=%.6lf..." (~250 bytes per sample)
+// sensor_bin.xml -> 17 network-order floats, optionally the sim time float, then a
+//                   4 byte magic footer (72 or 76 bytes)
+class FGDecoder {
+public:
+    // Binary layout, field order matches the chunk order in sensor_bin.xml
+    static constexpr std::size_t BINARY_FIELD_COUNT = 17;
+    static constexpr uint32_t BINARY_MAGIC = 0x43313732; // "C172", <binary_footer> in sensor_bin.xml
+    static constexpr std::size_t BINARY_PACKET_SIZE = BINARY_FIELD_COUNT * sizeof(float) + sizeof(uint32_t);
+    static constexpr std::size_t BINARY_STAMPED_PACKET_SIZE = BINARY_PACKET_SIZE + sizeof(float);
+
+    // Parse a text line, returns true if any known field was found.
+    // SEQ= and ST= tokens go to stamp when given, they don't count as sensor fields.
+    static bool parseText(const std::string& line, SensorData& data, StreamStamp* stamp = nullptr);
+
+    // Decode a binary datagram, returns false if the length or footer does not match
+    static bool parseBinary(const char* buffer, std::size_t length, SensorData& data, StreamStamp* stamp = nullptr);
+};
\ No newline at end of file
@@ -0,0 +1,129 @@
+#include "FlightSummary.hpp"
+#include "AlertManager.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <iostream>
+
+/*-------------------------------------------------------------------------------------
+// Title: FlightSummary::add
+// Description:
+// Fold one sample into the totals. The interval since the previous sample is
+// credited to the previous sample's state (airborne, above ceiling, fuel flow),
+// peaks and maxima take the new sample.
+-------------------------------------------------------------------------------------*/
+void FlightSummary::add(const PipelineSample& sample) {
+    const SensorData& d = sample.data;
+
+    if (stats.samples == 0) {
+        stats.startTime = sample.time;
+        stats.fuelStart = d.fuelCap;
+        stats.maxAltitude = d.altitude;
+        stats.maxSpeed = d.speed;
+    } else {
+        const double dt = std::max(0.0, sample.time - lastTime);
+        if (last.agl > Thresholds::AIRBORNE_AGL) stats.airborneTime += dt;
+        if (last.altitude > Thresholds::FLIGHT_CEIL) stats.timeAboveCeiling += dt;
+        fuelFlowIntegral += last.fuelFlow * dt;
+    }
+
+    ++stats.samples;
+    stats.duration = sample.time - stats.startTime;
+    stats.maxAltitude = std::max(stats.maxAltitude, d.altitude);
+    stats.maxSpeed = std::max(stats.maxSpeed, d.speed);
+    stats.peakPitchRate = std::max(stats.peakPitchRate, std::fabs(d.pitchRate));
+    stats.peakRollRate = std::max(stats.peakRollRate, std::fabs(d.rollRate));
+    stats.peakYawRate = std::max(stats.peakYawRate, std::fabs(d.yawRate));
+    stats.fuelLatest = d.fuelCap;
+    stats.fuelBurned = fuelFlowIntegral / 3600.0;
+    stats.averageFuelFlow = stats.duration > 0.0 ? fuelFlowIntegral / stats.duration : d.fuelFlow;
+
+    lastTime = sample.time;
+    last = d;
+}// End of FlightSummary::add
+
+void FlightSummary::process(const PipelineSample* samples, std::size_t count) {
+    if (count == 0) return;
+    for (std::size_t i = 0; i < count; ++i) add(samples[i]);
+
+    std::lock_guard<std::mutex> lock(publishedMutex);
+    published = stats;
+}
+
+FlightSummaryStats FlightSummary::snapshot() {
+    std::lock_guard<std::mutex> lock(publishedMutex);
+    return published;
+}
+
+// %.3f text of value, or missing when it is nan or inf
+static const char* formatValue(char (&text)[32], double value, const char* missing) {
+    if (!std::isfinite(value)) return missing;
+    std::snprintf(text, sizeof(text), "%.3f", value);
+    return text;
+}
+
+/*-------------------------------------------------------------------------------------
+// Title: FlightSummary::writeReport
+// Description:
+// Write the latest totals as one JSON object and as "Metric,Value" CSV rows, with the
+// alert counts and durations of the AlertHistory. Alerts that were never raised are
+// left out of both. JSON has no nan or inf, so a value that is not finite is null.
+-------------------------------------------------------------------------------------*/
+bool FlightSummary::writeReport(const std::string& directory) {
+    const FlightSummaryStats s = snapshot();
+    const std::array<AlertStats, ALERT_COUNT> alertStats = alerts.getStats();
+
+    struct Metric { const char* name; double value; };
+    const Metric metrics[] = {
+        {"samples", (double)s.samples},
+        {"duration_s", s.duration},
+        {"airborne_s", s.airborneTime},
+        {"max_altitude_ft", s.maxAltitude},
+        {"max_speed_kt", s.maxSpeed},
+        {"time_above_ceiling_s", s.timeAboveCeiling},
+        {"fuel_start_gal", s.fuelStart},
+        {"fuel_end_gal", s.fuelLatest},
+        {"fuel_burned_gal", s.fuelBurned},
+        {"average_fuel_flow_gph", s.averageFuelFlow},
+        {"peak_pitch_rate_dps", s.peakPitchRate},
+        {"peak_roll_rate_dps", s.peakRollRate},
+        {"peak_yaw_rate_dps", s.peakYawRate},
+    };
+
+    const std::string jsonPath = directory + "/flight_summary.json";
+    const std::string csvPath = directory + "/flight_summary.csv";
+    std::FILE* json = std::fopen(jsonPath.c_str(), "w");
+    std::FILE* csv = std::fopen(csvPath.c_str(), "w");
+    if (!json || !csv) {
+        std::cerr << "[FlightSummary] Error when trying to open " << (json ? csvPath : jsonPath) << std::endl;
+        if (json) std::fclose(json);
+        if (csv) std::fclose(csv);
+        return false;
+    }
+
+    std::fprintf(json, "{\n");
+    std::fprintf(csv, "Metric,Value\n");
+    char text[32];
+    for (const Metric& m : metrics) {
+        std::fprintf(json, "  \"%s\": %s,\n", m.name, formatValue(text, m.value, "null"));
+        std::fprintf(csv, "%s,%s\n", m.name, formatValue(text, m.value, ""));
+    }
+    std::fprintf(json, "  \"alerts\": {");
+    bool first = true;
+    for (int i = 0; i < ALERT_COUNT; ++i) {
+        const AlertStats& a = alertStats[i];
+        if (a.count == 0) continue;
+        std::fprintf(json, "%s\n    \"%s\": {\"raised\": %u, \"active_s\": %s}",
+                     first ? "" : ",", ALERT_NAMES[i], a.count, formatValue(text, a.totalDuration, "null"));
+        std::fprintf(csv, "%s raised,%u\n%s active_s,%s\n", ALERT_NAMES[i], a.count,
+                     ALERT_NAMES[i], formatValue(text, a.totalDuration, ""));
+        first = false;
+    }
+    std::fprintf(json, first ? "}\n}\n" : "\n  }\n}\n");
+
+    const bool ok = !std::ferror(json) && !std::ferror(csv);
+    std::fclose(json);
+    std::fclose(csv);
+    std::cout << "[FlightSummary] Report written to " << jsonPath << "\n";
+    return ok;
+}// End of FlightSummary::writeReport
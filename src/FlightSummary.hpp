@@ -0,0 +1,58 @@
+#pragma once
+
+#include "PipelineSample.hpp"
+#include "AlertHistory.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+
+// Whole-flight totals, every field is kept up to date sample by sample
+struct FlightSummaryStats {
+    uint64_t samples = 0;
+    double startTime = 0.0;         // Pipeline seconds of the first sample
+    double duration = 0.0;          // Seconds from the first to the latest sample
+    double airborneTime = 0.0;      // Seconds with agl > 5 ft
+    double maxAltitude = 0.0;       // ft
+    double maxSpeed = 0.0;          // kt
+    double timeAboveCeiling = 0.0;  // Seconds above Thresholds::FLIGHT_CEIL
+    double fuelStart = 0.0;         // gal in the tanks at the first sample
+    double fuelLatest = 0.0;        // gal at the latest sample
+    double fuelBurned = 0.0;        // gal, fuel flow integrated over time
+    double averageFuelFlow = 0.0;   // gph, time weighted
+    double peakPitchRate = 0.0;     // deg/s, absolute
+    double peakRollRate = 0.0;      // deg/s, absolute
+    double peakYawRate = 0.0;       // deg/s, absolute
+};
+
+// Accumulates FlightSummaryStats in the analyze stage with constant work per sample
+// (no history is kept), so the report is ready the moment the pipeline stops however
+// long the flight was. Time-weighted values give each interval between two samples
+// the state of the earlier one. Alert counts and durations come from the AlertHistory
+// the analyze stage feeds.
+class FlightSummary {
+public:
+    explicit FlightSummary(AlertHistory& alerts) : alerts(alerts) {}
+
+    // Analyze stage: fold a batch in, then publish one copy for readers
+    void process(const PipelineSample* samples, std::size_t count);
+
+    // Thread-safe copy of the latest totals (GUI, shutdown report)
+    FlightSummaryStats snapshot();
+
+    // Write <directory>/flight_summary.json and flight_summary.csv, false if either fails.
+    // A value that is not finite is written as null (JSON) or left empty (CSV)
+    bool writeReport(const std::string& directory);
+
+private:
+    AlertHistory& alerts;
+    FlightSummaryStats stats;      // Analyze thread only
+    double lastTime = 0.0;
+    SensorData last{};
+    double fuelFlowIntegral = 0.0; // gph * s
+
+    std::mutex publishedMutex;
+    FlightSummaryStats published;  // Copy readers get
+
+    void add(const PipelineSample& sample);
+};
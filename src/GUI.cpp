@@ -9,14 +9,23 @@
 
 #include <glad/glad.h> // GLAD loader for OpenGL
 #include "GUI.hpp"
+#include "ThreadControl.hpp"
 #include <iostream>    //for std::cerr
+#include <algorithm>
+#include <cmath>
+#include <cstring>
 
 // Init window dimensions
 const GLuint WIDTH = 1280, HEIGHT = 720;
 // Tracks if window is open 
 bool opened;
 
-bool GUI::init() {
+bool GUI::init(const PipelineConfig& config) {
+    // Frame pacing limits
+    maxFps = config.maxFps;
+    minFps = config.minFps;
+    unfocusedFps = config.unfocusedFps;
+
     // Init GLFW library
     if (!glfwInit()){
         std::cerr << "Failed to initialize GLFW\n";
@@ -46,15 +55,25 @@ bool GUI::init() {
     }
 
     opened = true;
+
+    // Input callbacks only flag that a redraw is needed. They are installed before the
+    // ImGui backend so ImGui chains them and still receives every event
+    glfwSetWindowUserPointer(window, this);
+    glfwSetCursorPosCallback(window, [](GLFWwindow* w, double, double) { markInput(w); });
+    glfwSetCursorEnterCallback(window, [](GLFWwindow* w, int) { markInput(w); });
+    glfwSetMouseButtonCallback(window, [](GLFWwindow* w, int, int, int) { markInput(w); });
+    glfwSetScrollCallback(window, [](GLFWwindow* w, double, double) { markInput(w); });
+    glfwSetKeyCallback(window, [](GLFWwindow* w, int, int, int, int) { markInput(w); });
+    glfwSetCharCallback(window, [](GLFWwindow* w, unsigned int) { markInput(w); });
+    glfwSetWindowFocusCallback(window, [](GLFWwindow* w, int) { markInput(w); });
+    glfwSetWindowSizeCallback(window, [](GLFWwindow* w, int, int) { markInput(w); });
+    glfwSetWindowRefreshCallback(window, [](GLFWwindow* w) { markInput(w); });
     
     // Init ImGui/ImPlot
     IMGUI_CHECKVERSION();
     ImGui::CreateContext();
     ImPlot::CreateContext();
 
-    //Init start time for real time plotting
-    startTime = ImGui::GetTime();
-
     //Bind ImGui/ImPlot to OpenGL
     ImGui_ImplGlfw_InitForOpenGL(window, true);
     ImGui_ImplOpenGL3_Init("#version 330");
@@ -65,8 +84,102 @@ bool GUI::init() {
     return true;
 }
 
+// Flag a redraw from a GLFW input callback
+void GUI::markInput(GLFWwindow* w) {
+    static_cast<GUI*>(glfwGetWindowUserPointer(w))->inputPending = true;
+}
+
+// Store latest sample for the live view and wake the render loop
+void GUI::setLatestData(const SensorData& data, const AlertFlags& alerts, const AnomalyFlags& anomalies,
+                        uint32_t customAlerts, const DerivedData& derived) {
+    {
+        std::lock_guard<std::mutex> latestDataLock(dataMutex);
+        if (std::memcmp(&alerts, &sharedAlerts, sizeof(AlertFlags)) != 0) alertChanged = true;
+        if (anomalies.any() != sharedAnomalies.any()) alertChanged = true;
+        if (customAlerts != sharedCustomAlerts) alertChanged = true;
+        sharedData = data;
+        sharedDerived = derived;
+        sharedAlerts = alerts;
+        sharedAnomalies = anomalies;
+        sharedCustomAlerts = customAlerts;
+    }
+    dataPending = true;
+    glfwPostEmptyEvent(); // Thread-safe, breaks glfwWaitEventsTimeout in waitForFrame
+}
+
+/*-------------------------------------------------------------------------------------
+// Title: GUI::waitForFrame
+// Description:
+// Event-driven frame pacing. Sleeps in glfwWaitEventsTimeout until new sensor data,
+// user input or an alert state change arrives, or until the min-fps deadline passes.
+// Redraws are capped at maxFps (unfocusedFps while the window is not focused), alert
+// changes skip the cap so they are shown right away. Nothing is drawn while minimized.
+// Returns true when a frame should be rendered.
+-------------------------------------------------------------------------------------*/
+bool GUI::waitForFrame() {
+    const bool focused = glfwGetWindowAttrib(window, GLFW_FOCUSED) != 0;
+    const double minInterval = 1.0 / (focused ? maxFps : std::min(maxFps, unfocusedFps));
+    const double maxInterval = 1.0 / minFps;
+
+    auto pending = [this] { return inputPending || settleFrames > 0 || dataPending || alertChanged; };
+
+    // Minimized, drop pending work and only wake for events
+    if (glfwGetWindowAttrib(window, GLFW_ICONIFIED)) {
+        dataPending = false;
+        alertChanged = false;
+        glfwWaitEventsTimeout(maxInterval);
+        return false;
+    }
+
+    // Sleep until something happens or the idle deadline passes
+    double now = glfwGetTime();
+    double timeout = lastFrameTime + maxInterval - now;
+    if (!pending() && timeout > 0.0) glfwWaitEventsTimeout(timeout);
+    else glfwPollEvents();
+
+    // Woken by an event that doesn't need a redraw
+    now = glfwGetTime();
+    if (!pending() && now - lastFrameTime < maxInterval) return false;
+
+    // Hold to the frame rate cap, events arriving meanwhile are still processed
+    const double frameDue = lastFrameTime + minInterval;
+    bool capped = false;
+    while (!alertChanged && now < frameDue && !glfwWindowShouldClose(window)) {
+        glfwWaitEventsTimeout(frameDue - now);
+        now = glfwGetTime();
+        capped = true;
+    }
+    if (capped) ThreadControl::jitter(ThreadRole::GUI).record(now - frameDue);
+
+    // Count the frames a fixed max-fps loop would have drawn in the gap
+    if (renderedFrames > 0) {
+        double missed = std::floor((now - lastFrameTime) * maxFps) - 1.0;
+        if (missed > 0.0) skippedFrames += (uint64_t)missed;
+    }
+
+    // Input keeps a few frames coming so hover/active highlights catch up
+    if (inputPending) settleFrames = 3;
+    else if (settleFrames > 0) --settleFrames;
+
+    inputPending = false;
+    dataPending = false;
+    alertChanged = false;
+    lastFrameTime = now;
+    return true;
+}// End of waitForFrame
+
 void GUI::render() {
-    glfwPollEvents(); // Process OS window events
+    ++renderedFrames;
+
+    // One consistent sample for the whole frame, the sink thread may be writing the next
+    {
+        std::lock_guard<std::mutex> latestDataLock(dataMutex);
+        latestData = sharedData;
+        latestDerived = sharedDerived;
+        latestAlerts = sharedAlerts;
+        latestAnomalies = sharedAnomalies;
+        latestCustomAlerts = sharedCustomAlerts;
+    }
 
     // Start new ImGui frame
     ImGui_ImplOpenGL3_NewFrame();
@@ -90,40 +203,46 @@ void GUI::render() {
         ImGuiWindowFlags_NoMove | ImGuiWindowFlags_NoCollapse |
         ImGuiWindowFlags_NoBringToFrontOnFocus | ImGuiWindowFlags_NoNavFocus)){
 
-        double currTime = ImGui::GetTime() - startTime;
-
-        // Safely update scrolling buffers with latest data
-        {
-            std::lock_guard<std::mutex> lock(dataMutex);
-            altitudeBuff.AddPoint((float)currTime, (float)latestData.altitude);
-            speedBuff.AddPoint((float)currTime, (float)latestData.speed);
-            vertSpeedBuff.AddPoint((float)currTime, (float)latestData.verticalSpeed);
-            engineRPMBuff.AddPoint((float)currTime, (float)latestData.engineRPM);
-            oilPressureBuff.AddPoint((float)currTime, (float)latestData.oilPressure);
-            fuelFlowBuff.AddPoint((float)currTime, (float)latestData.fuelFlow);
-        }
+        // Follow the latest sample unless the user panned away
+        const double latest = history.latestTime();
+        const double setMin = followLive ? latest - viewSpan : viewMin;
+        const double setMax = followLive ? latest : viewMax;
+        viewMin = setMin;
+        viewMax = setMax;
 
         // Left column: flight performance graphs
         ImGui::BeginChild("LeftGraphs", ImVec2(375, 675), true);
-        drawAltitudeGraph(currTime);
-        drawSpeedGraph(currTime);
-        drawVertSpeedGraph(currTime);
+        drawAltitudeGraph();
+        drawSpeedGraph();
+        drawVertSpeedGraph();
         ImGui::EndChild();
 
         ImGui::SameLine();
         
         // Middle column: engine/fuel graphs
         ImGui::BeginChild("RightGraphs", ImVec2(375, 675), true);
-        drawEngineRPMGraph(currTime);
-        drawOilPresGraph(currTime);
-        drawFuelFlowGraph(currTime);
+        drawEngineRPMGraph();
+        drawOilPresGraph();
+        drawFuelFlowGraph();
         ImGui::EndChild();
+
+        // A plot was zoomed (keep following with the new span) or panned (stop following)
+        if (viewMin != setMin || viewMax != setMax) {
+            const double span = viewMax - viewMin;
+            if (std::fabs(span - viewSpan) > 1e-6 * viewSpan) viewSpan = span;
+            else followLive = false;
+        }
         
         ImGui::SameLine(0.0f, 20.0f); // spacing
 
         // Right panel: live numeric data
         ImGui::BeginGroup();
+        drawTimeAxisControls();
         drawTextData();
+        drawFrameStats();
+        drawPipelineStats();
+        drawStreamHealth();
+        drawFlightSummary();
         ImGui::EndGroup();
 
         ImGui::SameLine(0.0f, 20.0f); // spacing
@@ -131,6 +250,9 @@ void GUI::render() {
         // Right most panel: alert statuses 
         ImGui::BeginGroup();
         drawAnomilies();
+        drawCustomAlerts();
+        drawDetectorAnomalies();
+        drawAlertHistory();
         ImGui::EndGroup();
     }
 
@@ -158,129 +280,106 @@ void GUI::shutdown() {
 }
 
 // Graphing Funcs
-void GUI::drawAltitudeGraph(double currTime){
-    if (!altitudeBuff.Data.empty() && ImPlot::BeginPlot("Altitude Plot", ImVec2(-1, 200))) {
-            ImPlot::SetupAxisLimits(ImAxis_X1, currTime - HISTORY, currTime, ImGuiCond_Always);
-
-            // Compute max altitude dynamically
-            float maxAltitude = 0.0f;
-            {
-                std::lock_guard<std::mutex> lock(dataMutex);
-                for (auto& p : altitudeBuff.Data)
-                    if (p.y > maxAltitude)
-                        maxAltitude = p.y;
-            }
-            maxAltitude = std::max(maxAltitude, static_cast<float>(latestData.altitude));
-
-            ImPlot::SetupAxisLimits(ImAxis_Y1, 0, maxAltitude, ImGuiCond_Always);
-
-            ImPlot::PlotLineG("Altitude",
-                [](int idx, void* data) -> ImPlotPoint {
-                    const ImVector<ImVec2>* vec = static_cast<const ImVector<ImVec2>*>(data);
-                    const ImVec2& pt = (*vec)[idx];
-                    return ImPlotPoint(pt.x, pt.y);
-                },
-                &altitudeBuff.Data, altitudeBuff.Data.size());
-
-            ImPlot::EndPlot();
-        }
-        ImGui::Text("Altitude: %.2f ft", latestData.altitude);
-        return;
+void GUI::drawAltitudeGraph(){
+    plotChannel("Altitude Plot", "Altitude", CH_ALTITUDE, 0, 0, true);
+    ImGui::Text("Altitude: %.2f ft", latestData.altitude);
 }
 
-void GUI::drawSpeedGraph(double currTime){
-    if (!speedBuff.Data.empty() && ImPlot::BeginPlot("Speed Plot", ImVec2(-1, 200))) {
-            ImPlot::SetupAxisLimits(ImAxis_X1, currTime - HISTORY, currTime, ImGuiCond_Always);
-            ImPlot::SetupAxisLimits(ImAxis_Y1, 0, 230, ImGuiCond_Always);
-
-            ImPlot::PlotLineG("Speed",
-                [](int idx, void* data) -> ImPlotPoint {
-                    const ImVector<ImVec2>* vec = static_cast<const ImVector<ImVec2>*>(data);
-                    const ImVec2& pt = (*vec)[idx];
-                    return ImPlotPoint(pt.x, pt.y);
-                },
-                &speedBuff.Data, speedBuff.Data.size());
-
-            ImPlot::EndPlot();
-        }
-        ImGui::Text("Speed: %.2f kt", latestData.speed);
-        return;
+void GUI::drawSpeedGraph(){
+    plotChannel("Speed Plot", "Speed", CH_SPEED, 0, 230);
+    ImGui::Text("Speed: %.2f kt", latestData.speed);
 }
 
-void GUI::drawVertSpeedGraph(double currTime){
-    if (!vertSpeedBuff.Data.empty() && ImPlot::BeginPlot("Vert Speed Plot", ImVec2(-1, 200))) {
-            ImPlot::SetupAxisLimits(ImAxis_X1, currTime - HISTORY, currTime, ImGuiCond_Always);
-            ImPlot::SetupAxisLimits(ImAxis_Y1, -5000, 5000, ImGuiCond_Always);
+void GUI::drawVertSpeedGraph(){
+    plotChannel("Vert Speed Plot", "Vert Speed", CH_VERTICAL_SPEED, -5000, 5000);
+    ImGui::Text("Vertical Speed: %.2f ft", latestData.verticalSpeed);
+}
 
-            ImPlot::PlotLineG("Vert Speed",
-                [](int idx, void* data) -> ImPlotPoint {
-                    const ImVector<ImVec2>* vec = static_cast<const ImVector<ImVec2>*>(data);
-                    const ImVec2& pt = (*vec)[idx];
-                    return ImPlotPoint(pt.x, pt.y);
-                },
-                &vertSpeedBuff.Data, vertSpeedBuff.Data.size());
-            
-            ImPlot::EndPlot();
-        }
-        ImGui::Text("Vertical Speed: %.2f ft", latestData.verticalSpeed);
-        return;
+void GUI::drawEngineRPMGraph(){
+    plotChannel("Engine RPM Plot", "Engine RPM", CH_ENGINE_RPM, 0, 3600);
+    ImGui::Text("Engine RPM: %.2f rpm", latestData.engineRPM);
 }
 
-void GUI::drawEngineRPMGraph(double currTime){
-    if (!engineRPMBuff.Data.empty() && ImPlot::BeginPlot("Engine RPM Plot", ImVec2(-1, 200))) {
-            ImPlot::SetupAxisLimits(ImAxis_X1, currTime - HISTORY, currTime, ImGuiCond_Always);
-            ImPlot::SetupAxisLimits(ImAxis_Y1, 0, 3600, ImGuiCond_Always);
+void GUI::drawOilPresGraph(){
+    plotChannel("Oil Pressure Plot", "Oil Pressure", CH_OIL_PRESSURE, 0, 150);
+    ImGui::Text("Oil Pressure: %.2f psi", latestData.oilPressure);
+}
 
-            ImPlot::PlotLineG("Engine RPM",
-                [](int idx, void* data) -> ImPlotPoint {
-                    const ImVector<ImVec2>* vec = static_cast<const ImVector<ImVec2>*>(data);
-                    const ImVec2& pt = (*vec)[idx];
-                    return ImPlotPoint(pt.x, pt.y);
-                },
-                &engineRPMBuff.Data, engineRPMBuff.Data.size());
-            
-            ImPlot::EndPlot();
-        }
-        ImGui::Text("Engine RPM: %.2f rpm", latestData.engineRPM);
-        return;
+void GUI::drawFuelFlowGraph(){
+    plotChannel("Fuel Flow Plot", "Fuel Flow", CH_FUEL_FLOW, 0, 30);
+    ImGui::Text("Fuel Flow: %.2f gph", latestData.fuelFlow);
 }
 
-void GUI::drawOilPresGraph(double currTime){
-    if (!oilPressureBuff.Data.empty() && ImPlot::BeginPlot("Oil Pressure Plot", ImVec2(-1, 200))) {
-            ImPlot::SetupAxisLimits(ImAxis_X1, currTime - HISTORY, currTime, ImGuiCond_Always);
-            ImPlot::SetupAxisLimits(ImAxis_Y1, 0, 150, ImGuiCond_Always);
+/*-------------------------------------------------------------------------------------
+// Title: GUI::plotChannel
+// Description:
+// Plot one channel over the shared time axis. The history store picks the coarsest
+// rollup tier that still has a point per pixel of the plot width, rollups are drawn as
+// a min/max band with the mean on top. The X axis is linked to viewMin/viewMax so
+// zooming or panning one plot moves all of them. With autoMax the Y axis is scaled
+// to the largest value in view.
+-------------------------------------------------------------------------------------*/
+void GUI::plotChannel(const char* title, const char* label, int channel, double yMin, double yMax, bool autoMax){
+    const int pixels = std::max(1, (int)ImGui::GetContentRegionAvail().x);
+    plotTier = history.query(channel, viewMin, viewMax, pixels, plotPoints);
+    if (plotPoints.empty()) return;
+
+    if (autoMax) {
+        yMax = 0.0;
+        for (const HistoryPoint& p : plotPoints) yMax = std::max(yMax, (double)p.max);
+        if (yMax <= yMin) yMax = yMin + 1.0;
+    }
+
+    if (ImPlot::BeginPlot(title, ImVec2(-1, 200))) {
+        ImPlot::SetupAxisLinks(ImAxis_X1, &viewMin, &viewMax);
+        ImPlot::SetupAxisLimits(ImAxis_Y1, yMin, yMax, ImGuiCond_Always);
 
-            ImPlot::PlotLineG("Oil Pressure",
+        if (plotTier > 0) {
+            ImPlot::SetNextFillStyle(IMPLOT_AUTO_COL, 0.25f);
+            ImPlot::PlotShadedG(label,
+                [](int idx, void* data) -> ImPlotPoint {
+                    const HistoryPoint& pt = (*static_cast<std::vector<HistoryPoint>*>(data))[idx];
+                    return ImPlotPoint(pt.time, pt.min);
+                }, &plotPoints,
                 [](int idx, void* data) -> ImPlotPoint {
-                    const ImVector<ImVec2>* vec = static_cast<const ImVector<ImVec2>*>(data);
-                    const ImVec2& pt = (*vec)[idx];
-                    return ImPlotPoint(pt.x, pt.y);
-                },
-                &oilPressureBuff.Data, oilPressureBuff.Data.size());
-            
-            ImPlot::EndPlot();
+                    const HistoryPoint& pt = (*static_cast<std::vector<HistoryPoint>*>(data))[idx];
+                    return ImPlotPoint(pt.time, pt.max);
+                }, &plotPoints, (int)plotPoints.size());
         }
-        ImGui::Text("Oil Pressure: %.2f psi", latestData.oilPressure);
-        return;
-}
 
-void GUI::drawFuelFlowGraph(double currTime){
-    if (!fuelFlowBuff.Data.empty() && ImPlot::BeginPlot("Fuel Flow Plot", ImVec2(-1, 200))) {
-            ImPlot::SetupAxisLimits(ImAxis_X1, currTime - HISTORY, currTime, ImGuiCond_Always);
-            ImPlot::SetupAxisLimits(ImAxis_Y1, 0, 30, ImGuiCond_Always);
+        ImPlot::PlotLineG(label,
+            [](int idx, void* data) -> ImPlotPoint {
+                const HistoryPoint& pt = (*static_cast<std::vector<HistoryPoint>*>(data))[idx];
+                return ImPlotPoint(pt.time, pt.mean);
+            },
+            &plotPoints, (int)plotPoints.size());
 
-            ImPlot::PlotLineG("Fuel Flow",
-                [](int idx, void* data) -> ImPlotPoint {
-                    const ImVector<ImVec2>* vec = static_cast<const ImVector<ImVec2>*>(data);
-                    const ImVec2& pt = (*vec)[idx];
-                    return ImPlotPoint(pt.x, pt.y);
-                },
-                &fuelFlowBuff.Data, fuelFlowBuff.Data.size());
-            
-            ImPlot::EndPlot();
+        ImPlot::EndPlot();
+    }
+}// End of plotChannel
+
+// Span presets and live follow for the shared time axis
+void GUI::drawTimeAxisControls(){
+    static const struct { const char* label; double seconds; } spans[] = {
+        {"10s", 10.0}, {"1m", 60.0}, {"10m", 600.0}, {"1h", 3600.0}
+    };
+    for (const auto& span : spans) {
+        if (ImGui::SmallButton(span.label)) {
+            viewSpan = span.seconds;
+            followLive = true;
         }
-        ImGui::Text("Fuel Flow: %.2f gph", latestData.fuelFlow);
-        return;
+        ImGui::SameLine();
+    }
+    if (ImGui::SmallButton("All")) {
+        viewSpan = std::max(HISTORY, history.latestTime() - history.earliestTime());
+        followLive = true;
+    }
+    ImGui::SameLine();
+    ImGui::Checkbox("Live", &followLive);
+
+    static const char* const tierNames[HistoryStore::TIER_COUNT] = {"raw", "1 s", "10 s", "1 min"};
+    ImGui::Text("Span: %.0f s, resolution: %s", viewMax - viewMin, tierNames[plotTier]);
+    ImGui::Spacing();
 }
 
 // Display numeric sensor data on screen
@@ -299,9 +398,32 @@ void GUI::drawTextData(){
     ImGui::Spacing();
     ImGui::Text("Yaw: %.2f °", latestData.yaw);
     ImGui::Text("Yaw Rate: %.2f °/s", latestData.yawRate);
+    ImGui::Spacing();
+    ImGui::Text("Density Altitude: %.0f ft", latestDerived.densityAltitude);
+    ImGui::Text("Endurance: %.0f min", latestDerived.endurance);
+    ImGui::Text("Range: %.0f nm", latestDerived.range);
+    ImGui::Text("Climb Gradient: %.1f %%", latestDerived.climbGradient);
+    ImGui::Text("Load Factor: %.2f g", latestDerived.loadFactor);
     return;
 } 
 
+// Display the pipeline clock, how much redraw work frame pacing saved and thread jitter
+void GUI::drawFrameStats(){
+    ImGui::Spacing();
+    if (clock) ImGui::Text("Clock: %s, %.1f s", clock->name(), clock->now());
+    ImGui::Text("Frames Rendered: %llu", (unsigned long long)renderedFrames);
+    ImGui::Text("Frames Skipped: %llu", (unsigned long long)skippedFrames);
+
+    // Late wake-ups per pipeline thread
+    ImGui::Spacing();
+    ImGui::Text("Jitter (mean/max us)");
+    for (int i = 0; i < THREAD_ROLE_COUNT; ++i) {
+        const JitterStats& j = ThreadControl::jitter(static_cast<ThreadRole>(i));
+        if (j.count() == 0) ImGui::TextDisabled("  %-8s not measured", threadRoleName(static_cast<ThreadRole>(i)));
+        else ImGui::Text("  %-8s %7.1f / %7.1f", threadRoleName(static_cast<ThreadRole>(i)), j.meanUs(), j.maxUs());
+    }
+}
+
 // Render all current anomaly alerts with color-coded status
 void GUI::drawAnomilies() {
     // Air Temp
@@ -339,6 +461,7 @@ void GUI::drawAnomilies() {
     DrawAlertLine("Low Fuel", latestAlerts.lowFuel);
     DrawAlertLine("Low Fuel Flow", latestAlerts.lowFuelFlow);
     DrawAlertLine("High Fuel Flow", latestAlerts.highFuelFlow);
+    DrawAlertLine("Low Endurance", latestAlerts.lowEndurance);
 
     ImGui::Spacing();
 
@@ -350,6 +473,123 @@ void GUI::drawAnomilies() {
     DrawAlertLine("Yaw Rate Exceeded", latestAlerts.yawRateExceeded);
 }
 
+// Alerts from the --rules file that aren't built-in, listed under their rule names
+void GUI::drawCustomAlerts() {
+    if (customAlertNames.empty()) return;
+    ImGui::Spacing();
+    for (std::size_t i = 0; i < customAlertNames.size(); ++i) {
+        DrawAlertLine(customAlertNames[i].c_str(), (latestCustomAlerts >> i) & 1u);
+    }
+}
+
+// Channels the statistical detector currently flags, shown under the threshold alerts
+void GUI::drawDetectorAnomalies() {
+    ImGui::Spacing();
+    ImGui::Text("Anomalies:");
+    if (latestAnomalies.any() == 0) {
+        ImGui::TextDisabled("  none");
+        return;
+    }
+    const ImVec4 orange(1.0f, 0.6f, 0.0f, 1.0f);
+    for (int c = 0; c < SENSOR_CHANNEL_COUNT; ++c) {
+        const uint32_t bit = 1u << c;
+        if (latestAnomalies.spike & bit) ImGui::TextColored(orange, "  Spike: %s", CHANNEL_NAMES[c]);
+        if (latestAnomalies.drift & bit) ImGui::TextColored(orange, "  Drift: %s", CHANNEL_NAMES[c]);
+    }
+}
+
+// Totals for the flight so far, the same numbers flight_summary.json gets at shutdown
+void GUI::drawFlightSummary(){
+    if (!flightSummary) return;
+    FlightSummaryStats st = flightSummary->snapshot();
+
+    ImGui::Spacing();
+    ImGui::Text("Flight Summary");
+    ImGui::Text("  %.0f s, airborne %.0f s", st.duration, st.airborneTime);
+    ImGui::Text("  Max altitude %.0f ft, above ceiling %.0f s", st.maxAltitude, st.timeAboveCeiling);
+    ImGui::Text("  Fuel burned %.2f gal, avg flow %.2f gph", st.fuelBurned, st.averageFuelFlow);
+    ImGui::Text("  Peak rates pitch %.1f roll %.1f yaw %.1f °/s", st.peakPitchRate, st.peakRollRate, st.peakYawRate);
+}
+
+// Queue depth and drops of every sink, shows which output can't keep up
+void GUI::drawPipelineStats(){
+    if (!pipeline) return;
+
+    ImGui::Spacing();
+    ImGui::Text("Sinks (queued/done/dropped)");
+    for (const SinkStatus& st : pipeline->getSinkStatus()) {
+        ImGui::Text("  %-10s %zu / %llu / %llu", st.name.c_str(), st.queued,
+                    (unsigned long long)st.consumed, (unsigned long long)st.dropped);
+    }
+}
+
+// Loss/reorder/rate of every UDP sender, a silent sender turns red after a second
+void GUI::drawStreamHealth(){
+    if (!streamMonitor) return;
+
+    ImGui::Spacing();
+    ImGui::Text("UDP Streams");
+    if (streamMonitor->sourceCount() == 0) {
+        ImGui::TextDisabled("  waiting for data");
+        return;
+    }
+    for (int i = 0; i < streamMonitor->sourceCount(); ++i) {
+        StreamHealthStats st = streamMonitor->snapshot(i);
+        if (st.idleSeconds > 1.0) ImGui::TextColored(ImVec4(1.0f, 0.0f, 0.0f, 1.0f), "  %s (silent %.0fs)", st.label, st.idleSeconds);
+        else ImGui::Text("  %s", st.label);
+        ImGui::Text("    %.1f Hz, jitter %.2f ms", st.rateHz, st.jitterMs);
+        ImGui::Text("    rx %llu lost %llu", (unsigned long long)st.received, (unsigned long long)st.lost);
+        ImGui::Text("    reord %llu dup %llu bad %llu", (unsigned long long)st.reordered,
+                    (unsigned long long)st.duplicated, (unsigned long long)st.malformed);
+    }
+}
+
+// Per-alert counts/durations and the latest raise/clear events
+void GUI::drawAlertHistory() {
+    if (!alertHistory) return;
+
+    ImGui::Spacing();
+    ImGui::Text("Alert History");
+
+    // Stats for every alert that has been raised at least once
+    std::array<AlertStats, ALERT_COUNT> stats = alertHistory->getStats();
+    ImGuiTableFlags flags = ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg | ImGuiTableFlags_ScrollY;
+    if (ImGui::BeginTable("AlertHistoryTable", 4, flags, ImVec2(0, 150))) {
+        ImGui::TableSetupScrollFreeze(0, 1);
+        ImGui::TableSetupColumn("Alert");
+        ImGui::TableSetupColumn("Count");
+        ImGui::TableSetupColumn("Total s");
+        ImGui::TableSetupColumn("Longest s");
+        ImGui::TableHeadersRow();
+
+        for (int i = 0; i < ALERT_COUNT; ++i) {
+            const AlertStats& st = stats[i];
+            if (st.count == 0) continue;
+
+            ImGui::TableNextRow();
+            ImGui::TableSetColumnIndex(0);
+            if (st.active) ImGui::TextColored(ImVec4(1.0f, 0.0f, 0.0f, 1.0f), "%s", ALERT_NAMES[i]);
+            else ImGui::TextUnformatted(ALERT_NAMES[i]);
+            ImGui::TableSetColumnIndex(1);
+            ImGui::Text("%u", st.count);
+            ImGui::TableSetColumnIndex(2);
+            ImGui::Text("%.1f", st.totalDuration);
+            ImGui::TableSetColumnIndex(3);
+            ImGui::Text("%.1f", st.longest);
+        }
+        ImGui::EndTable();
+    }
+
+    // Newest events first
+    ImGui::BeginChild("AlertEvents", ImVec2(0, 120), true);
+    std::deque<AlertEvent> events = alertHistory->getRecentEvents();
+    for (auto it = events.rbegin(); it != events.rend(); ++it) {
+        if (it->raised) ImGui::Text("%8.1fs RAISE %s", it->time, ALERT_NAMES[it->alert]);
+        else ImGui::Text("%8.1fs CLEAR %s (%.1fs)", it->time, ALERT_NAMES[it->alert], it->duration);
+    }
+    ImGui::EndChild();
+}
+
 // Helper to render a single alert line with color depending on status
 void GUI::DrawAlertLine(const char* label, bool triggered) {
     ImU32 color = triggered ? IM_COL32(255, 0, 0, 255) : IM_COL32(255, 255, 255, 255);
@@ -1,78 +1,134 @@
 #pragma once
 
 #include "AlertFlags.hpp"
+#include "AlertHistory.hpp"
 #include "SensorData.hpp"
+#include "DerivedData.hpp"
+#include "Config.hpp"
+#include "Pipeline.hpp"
+#include "HistoryStore.hpp"
+#include "StreamHealth.hpp"
+#include "FlightSummary.hpp"
+#include "Clock.hpp"
 #include <GLFW/glfw3.h>
 #include "imgui.h"
 #include <vector>
+#include <string>
 #include <mutex>
+#include <atomic>
+#include <cstdint>
 
-// utility structure for realtime plot
-struct ScrollingBuffer {
-    int MaxSize;
-    int Offset;
-    ImVector<ImVec2> Data;
-    ScrollingBuffer(int max_size = 2000) {
-        MaxSize = max_size;
-        Offset  = 0;
-        Data.reserve(MaxSize);
-    }
-    void AddPoint(float x, float y) {
-        if (Data.size() >= MaxSize){
-            Data.erase(Data.begin());  // Remove oldest point
-        }
-        Data.push_back(ImVec2(x, y));  // Add newest point
+// Dashboard window, fed by the pipeline as the "gui" sink
+class GUI : public Sink {
+public:
+    bool init(const PipelineConfig& config); // Set up ImGui, window, etc.
+    bool waitForFrame();             // Sleep until a frame is due, false if nothing to draw
+    void render();                   // Draw one frame
+    void shutdown();                 // Cleanup
+
+    // Pass in for live view, safe to call from any thread, wakes the render loop
+    void setLatestData(const SensorData& data, const AlertFlags& alerts, const AnomalyFlags& anomalies = {},
+                       uint32_t customAlerts = 0, const DerivedData& derived = {});
+
+    // Sink interface, runs on the gui sink thread
+    const char* name() const override { return "gui"; }
+    void consume(const PipelineSample& sample) override {
+        history.add(sample.data, sample.time);
+        setLatestData(sample.data, sample.alerts, sample.anomalies, sample.customAlerts, sample.derived);
     }
-    void Erase() {
-        if (Data.size() > 0) {
-            Data.shrink(0);
-            Offset  = 0;
-        }
+    void consumeBatch(const std::vector<PipelineSample>& batch) override { // One wake-up per batch
+        if (batch.empty()) return;
+        for (const PipelineSample& sample : batch) history.add(sample.data, sample.time);
+        const PipelineSample& last = batch.back();
+        setLatestData(last.data, last.alerts, last.anomalies, last.customAlerts, last.derived);
     }
-};
 
-class GUI {
-public:
-    bool init();                     // Set up ImGui, window, etc.
-    void render();                   // Called every frame
-    void shutdown();                 // Cleanup
+    // Source for the alert history table, fed by the analyze stage
+    void setAlertHistory(AlertHistory* history){ alertHistory = history; }
 
-    void setLatestData(const SensorData& data, const AlertFlags& alerts){// Pass in for live view
-        std::lock_guard<std::mutex> latestDataLock(dataMutex);
-        latestData = data;
-        latestAlerts = alerts;
-    }  
+    // Source for the per-sink queue/drop display
+    void setPipeline(Pipeline* p){ pipeline = p; }
+
+    // Names of the custom --rules alerts, set before the pipeline starts
+    void setCustomAlertNames(const std::vector<std::string>& names){ customAlertNames = names; }
+
+    // Source for the UDP stream health display (FlightGear mode only)
+    void setStreamMonitor(StreamMonitor* m){ streamMonitor = m; }
+
+    // Source for the live flight summary
+    void setFlightSummary(FlightSummary* s){ flightSummary = s; }
+
+    // Clock samples are stamped with, shown next to the frame stats
+    void setClock(Clock* c){ clock = c; }
 
     GLFWwindow* window;
 
 private:
-    // Time config
-    double startTime = 0.0;
-    static constexpr float HISTORY = 10.0f;
+    // Time axis shared by all plots, zoomed with the mouse wheel or the span buttons
+    static constexpr double HISTORY = 10.0; // Default span in seconds
+    double viewMin = 0.0, viewMax = HISTORY; // Linked X limits of every plot
+    double viewSpan = HISTORY;
+    bool followLive = true;                  // Right edge tracks the latest sample
+
+    // Frame pacing
+    double maxFps = 60.0;
+    double minFps = 1.0;
+    double unfocusedFps = 5.0;
+    double lastFrameTime = 0.0;
+    int settleFrames = 0;                   // Extra frames after input so ImGui hover/active state settles
+    bool inputPending = false;              // Set by GLFW input callbacks (main thread only)
+    std::atomic<bool> dataPending{false};   // New sample since last frame
+    std::atomic<bool> alertChanged{false};  // Alert state differs from last sample
+    uint64_t renderedFrames = 0;
+    uint64_t skippedFrames = 0;             // Frames a fixed max-fps loop would have drawn but we didn't
+    static void markInput(GLFWwindow* w);
 
-    // Thead-safe shared data
+    // Thead-safe shared data, written by whichever thread runs the gui sink
     std::mutex dataMutex;
-    SensorData latestData;
-    AlertFlags latestAlerts;
+    SensorData sharedData{};
+    DerivedData sharedDerived{};
+    AlertFlags sharedAlerts{};
+    AnomalyFlags sharedAnomalies{};
+    uint32_t sharedCustomAlerts = 0;
+
+    // Copy of the shared data taken under dataMutex at the top of render, every draw
+    // function reads only these so a frame shows one whole sample
+    SensorData latestData{};
+    DerivedData latestDerived{};
+    AlertFlags latestAlerts{};
+    AnomalyFlags latestAnomalies{};
+    uint32_t latestCustomAlerts = 0;
+    std::vector<std::string> customAlertNames;
+    AlertHistory* alertHistory = nullptr;
+    Pipeline* pipeline = nullptr;
+    StreamMonitor* streamMonitor = nullptr;
+    FlightSummary* flightSummary = nullptr;
+    Clock* clock = nullptr;
 
-    // Buffers for graphs 
-    ScrollingBuffer altitudeBuff;
-    ScrollingBuffer speedBuff;
-    ScrollingBuffer vertSpeedBuff;
-    ScrollingBuffer engineRPMBuff;
-    ScrollingBuffer oilPressureBuff;
-    ScrollingBuffer fuelFlowBuff; 
+    // Whole-flight history for the graphs, fed by the gui sink thread
+    HistoryStore history;
+    std::vector<HistoryPoint> plotPoints; // Reused by every plot
+    int plotTier = 0;                     // Tier the last plot was drawn from
 
     // Graphing funcs
-    void drawAltitudeGraph(double currTime);
-    void drawSpeedGraph(double currTime);
-    void drawVertSpeedGraph(double currTime);
-    void drawEngineRPMGraph(double currTime);
-    void drawOilPresGraph(double currTime);
-    void drawFuelFlowGraph(double currTime);
+    void drawAltitudeGraph();
+    void drawSpeedGraph();
+    void drawVertSpeedGraph();
+    void drawEngineRPMGraph();
+    void drawOilPresGraph();
+    void drawFuelFlowGraph();
+    void plotChannel(const char* title, const char* label, int channel, double yMin, double yMax, bool autoMax = false);
+    void drawTimeAxisControls();
 
     // Gui helper funcs
     void drawTextData();
     void drawAnomilies();
+    void drawCustomAlerts();
+    void drawDetectorAnomalies();
+    void drawFrameStats();
+    void drawPipelineStats();
+    void drawStreamHealth();
+    void drawFlightSummary();
+    void drawAlertHistory();
     void DrawAlertLine(const char* label, bool triggered); 
 };
\ No newline at end of file
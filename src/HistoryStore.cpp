@@ -0,0 +1,151 @@
+#include "HistoryStore.hpp"
+#include <algorithm>
+#include <cmath>
+
+constexpr double HistoryStore::TIER_SECONDS[];
+constexpr std::size_t HistoryStore::TIER_CAPACITY[];
+
+// Constructor, all memory is allocated up front
+HistoryStore::HistoryStore() {
+    for (int t = 0; t < TIER_COUNT; ++t) {
+        tiers[t].items.resize(TIER_CAPACITY[t]);
+    }
+}
+
+// Append, overwriting the oldest bucket when full
+void HistoryStore::Ring::push(const Bucket& b) {
+    if (size < items.size()) {
+        items[(start + size) % items.size()] = b;
+        ++size;
+    } else {
+        items[start] = b;
+        start = (start + 1) % items.size();
+        ++evicted;
+    }
+}
+
+void HistoryStore::add(const SensorData& data, double time) {
+    Bucket raw;
+    raw.time = time;
+    raw.count = 1;
+    for (int c = 0; c < SENSOR_CHANNEL_COUNT; ++c) {
+        float v = static_cast<float>(channelValue(data, c));
+        raw.min[c] = raw.max[c] = raw.mean[c] = v;
+    }
+
+    std::lock_guard<std::mutex> lock(historyMutex);
+    tiers[0].push(raw);
+    rollUp(1, raw);
+}
+
+/*-------------------------------------------------------------------------------------
+// Title: HistoryStore::rollUp
+// Description:
+// Merge a sample or closed bucket of the tier below into the open bucket of `tier`.
+// When b starts a new bucket the open one is closed, stored in the tier's ring and
+// merged into the next coarser tier, so each level only ever sees finished buckets.
+-------------------------------------------------------------------------------------*/
+void HistoryStore::rollUp(int tier, const Bucket& b) {
+    OpenBucket& o = open[tier];
+    const double res = TIER_SECONDS[tier];
+    const double bucketStart = std::floor(b.time / res) * res;
+
+    if (o.count > 0 && bucketStart != o.time) {
+        Bucket closed = close(o);
+        tiers[tier].push(closed);
+        if (tier + 1 < TIER_COUNT) rollUp(tier + 1, closed);
+        o.count = 0;
+    }
+
+    if (o.count == 0) {
+        o.time = bucketStart;
+        for (int c = 0; c < SENSOR_CHANNEL_COUNT; ++c) {
+            o.min[c] = b.min[c];
+            o.max[c] = b.max[c];
+            o.sum[c] = 0.0;
+        }
+    }
+    for (int c = 0; c < SENSOR_CHANNEL_COUNT; ++c) {
+        o.min[c] = std::min(o.min[c], b.min[c]);
+        o.max[c] = std::max(o.max[c], b.max[c]);
+        o.sum[c] += static_cast<double>(b.mean[c]) * b.count;
+    }
+    o.count += b.count;
+}// End of rollUp
+
+HistoryStore::Bucket HistoryStore::close(const OpenBucket& o) {
+    Bucket b;
+    b.time = o.time;
+    b.count = o.count;
+    for (int c = 0; c < SENSOR_CHANNEL_COUNT; ++c) {
+        b.min[c] = o.min[c];
+        b.max[c] = o.max[c];
+        b.mean[c] = static_cast<float>(o.sum[c] / o.count);
+    }
+    return b;
+}
+
+bool HistoryStore::covers(int tier, double t0) const {
+    const Ring& r = tiers[tier];
+    return r.evicted == 0 || (r.size > 0 && r.at(0).time <= t0);
+}
+
+/*-------------------------------------------------------------------------------------
+// Title: HistoryStore::query
+// Description:
+// Pick a tier for the range [t0, t1] shown `pixels` wide: walk from the coarsest tier
+// to finer ones while they still reach back to t0, and stop at the first one with at
+// least one bucket per pixel. The buckets in range (plus one on either side so the
+// line runs to the plot edges) and the tier's open bucket are copied out, so the
+// cost depends on the plot width rather than the length of the flight.
+-------------------------------------------------------------------------------------*/
+int HistoryStore::query(int channel, double t0, double t1, int pixels, std::vector<HistoryPoint>& out) {
+    out.clear();
+    std::lock_guard<std::mutex> lock(historyMutex);
+
+    int tier = TIER_COUNT - 1;
+    for (int t = TIER_COUNT - 1; t >= 0; --t) {
+        if (!covers(t, t0)) break;
+        tier = t;
+        if (t == 0 || (t1 - t0) / TIER_SECONDS[t] >= pixels) break;
+    }
+
+    const Ring& r = tiers[tier];
+
+    // First bucket at or after t0, then step back one
+    std::size_t lo = 0, hi = r.size;
+    while (lo < hi) {
+        std::size_t mid = (lo + hi) / 2;
+        if (r.at(mid).time < t0) lo = mid + 1;
+        else hi = mid;
+    }
+    if (lo > 0) --lo;
+
+    for (std::size_t i = lo; i < r.size; ++i) {
+        const Bucket& b = r.at(i);
+        out.push_back({b.time, b.min[channel], b.max[channel], b.mean[channel]});
+        if (b.time > t1) break;
+    }
+
+    // Partial bucket, keeps rollup plots running up to the latest sample
+    if (tier > 0 && open[tier].count > 0 && open[tier].time <= t1) {
+        const OpenBucket& o = open[tier];
+        out.push_back({o.time, o.min[channel], o.max[channel],
+                       static_cast<float>(o.sum[channel] / o.count)});
+    }
+    return tier;
+}// End of query
+
+double HistoryStore::earliestTime() {
+    std::lock_guard<std::mutex> lock(historyMutex);
+    for (int t = TIER_COUNT - 1; t >= 0; --t) {
+        if (tiers[t].size > 0) return tiers[t].at(0).time;
+    }
+    return 0.0;
+}
+
+double HistoryStore::latestTime() {
+    std::lock_guard<std::mutex> lock(historyMutex);
+    const Ring& raw = tiers[0];
+    return raw.size > 0 ? raw.at(raw.size - 1).time : 0.0;
+}
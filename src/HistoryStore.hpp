@@ -0,0 +1,84 @@
+#pragma once
+
+#include "SensorData.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+// One plotted point of a history tier. Raw samples have min == max == mean.
+struct HistoryPoint {
+    double time; // Sample time, or bucket start for rollups (seconds since the pipeline started)
+    float min;
+    float max;
+    float mean;
+};
+
+// Whole-flight history for plotting.
+// Every sample goes into a raw ring and is rolled up incrementally into 1 s buckets,
+// closed 1 s buckets into 10 s buckets and those into 1 min buckets, each holding
+// min/max/mean of every channel. All tiers are fixed size rings, so memory is constant
+// and a plot reads a bounded number of points whatever range it shows.
+class HistoryStore {
+public:
+    static constexpr int TIER_COUNT = 4;      // Raw, 1 s, 10 s, 1 min
+    static constexpr double TIER_SECONDS[TIER_COUNT] = {0.0, 1.0, 10.0, 60.0};
+    static constexpr std::size_t TIER_CAPACITY[TIER_COUNT] = {
+        4096,  // Raw samples (~34 min at 2 Hz, ~68 s at 60 Hz)
+        7200,  // 2 h of 1 s buckets
+        4320,  // 12 h of 10 s buckets
+        4320   // 72 h of 1 min buckets
+    };
+
+    HistoryStore();
+
+    // Add one sample, time in seconds since the pipeline started
+    void add(const SensorData& data, double time);
+
+    // Copy the points of one channel covering [t0, t1] into out. Uses the coarsest tier
+    // that still gives at least `pixels` points over the range, falling back to finer
+    // tiers only while they still reach back to t0. Returns the tier used.
+    int query(int channel, double t0, double t1, int pixels, std::vector<HistoryPoint>& out);
+
+    // Time span held, 0 when empty
+    double earliestTime();
+    double latestTime();
+
+private:
+    // Stats of every channel over one bucket (or one raw sample)
+    struct Bucket {
+        double time;
+        uint32_t count;
+        float min[SENSOR_CHANNEL_COUNT];
+        float max[SENSOR_CHANNEL_COUNT];
+        float mean[SENSOR_CHANNEL_COUNT];
+    };
+
+    // Fixed size ring of buckets, oldest first
+    struct Ring {
+        std::vector<Bucket> items;
+        std::size_t start = 0;
+        std::size_t size = 0;
+        uint64_t evicted = 0;  // Buckets overwritten so far
+
+        const Bucket& at(std::size_t i) const { return items[(start + i) % items.size()]; }
+        void push(const Bucket& b);
+    };
+
+    // Bucket still being filled for a rollup tier
+    struct OpenBucket {
+        double time = 0.0;
+        uint32_t count = 0;
+        float min[SENSOR_CHANNEL_COUNT];
+        float max[SENSOR_CHANNEL_COUNT];
+        double sum[SENSOR_CHANNEL_COUNT];  // Sum of mean * count
+    };
+
+    void rollUp(int tier, const Bucket& b);   // Merge b into tier's open bucket, closing it on a boundary
+    bool covers(int tier, double t0) const;   // Tier still holds data from t0 on
+    static Bucket close(const OpenBucket& open);
+
+    std::mutex historyMutex;
+    Ring tiers[TIER_COUNT];
+    OpenBucket open[TIER_COUNT];  // Index 0 unused, raw samples are never open
+};
@@ -1,110 +1,238 @@
 #include "Logger.hpp"
-#include "AlertManager.hpp"
 #include <iostream>
-#include <chrono>
-#include <ctime>
-#include <iomanip>
 #include <cmath>
+#include <cstdio>
 
 // Constructor
-Logger::Logger() {
+Logger::Logger(const std::string& directory) : directory(directory) {
     std::cout << "[Logger] Initializing...\n";
 
-    output.open("data/sensor_log.csv", std::ios::out); // Clear file on startup
+    output.open(directory + "/sensor_log.csv", std::ios::out); // Clear file on startup
     if (!output.is_open()) {
         std::cerr << "[Logger] Error when trying to open file" << std::endl;
     } else {
         std::cout << "[Logger] File is opened.\n";
         output << "Timestamp,Temperature,Altitude,Speed,Vertical Speed,Engine RPMs,Throttle,"
                << "Oil Pressure,Oil Temperature,Fuel Capacity,Fuel Flow,Pitch,Pitch Rate,Roll,"
-               << "Roll Rate,Yaw,Yaw Rate,Alerts"
+               << "Roll Rate,Yaw,Yaw Rate,Density Altitude,Endurance,Range,Climb Gradient,Load Factor,Alerts"
                << std::endl;
     }
+
+    // Compact log of alert transitions, one row per raise or clear
+    eventOutput.open(directory + "/alert_events.csv", std::ios::out);
+    if (!eventOutput.is_open()) {
+        std::cerr << "[Logger] Error when trying to open alert event file" << std::endl;
+    } else {
+        eventOutput << "Timestamp,Seconds,Alert,Event,Duration" << std::endl;
+    }
 }
 
 // Deconstructor
 Logger::~Logger(){
+    logStreamHealth(true); // Final totals
     if (output.is_open()){
         output.close();
         std::cout << "File closed.\n";
     }
+    if (asyncOutput.isOpen()){
+        asyncOutput.close();
+        std::cout << "File closed.\n";
+        if (asyncOutput.peakPending() > WRITER_BEHIND_BYTES){
+            std::cout << "[Logger] CSV writer fell behind, queued up to "
+                      << asyncOutput.peakPending() / 1024 << " KB\n";
+        }
+    }
+    if (asyncOutput.failedWrites() || asyncEventOutput.failedWrites()){
+        std::cerr << "[Logger] " << asyncOutput.failedWrites() + asyncEventOutput.failedWrites()
+                  << " CSV writes failed" << std::endl;
+    }
+    if (eventOutput.is_open()){
+        eventOutput.close();
+    }
+    if (healthOutput.is_open()){
+        healthOutput.close();
+    }
+}
+
+// Hand the logs to writer threads so the reactor thread never waits for the disk,
+// after the headers the constructor wrote. Stream health rows stay synchronous, one
+// every few seconds
+void Logger::beginInline() {
+    if (output.is_open()) {
+        output.close();
+        asyncOutput.open(directory + "/sensor_log.csv");
+    }
+    if (eventOutput.is_open()) {
+        eventOutput.close();
+        asyncEventOutput.open(directory + "/alert_events.csv");
+    }
 }
 
-// Utility function to get the current time in ISO 8601 format (UTC)
-std::string get_iso8601_utc() {
-    auto now = std::chrono::system_clock::now();
-    std::time_t now_c = std::chrono::system_clock::to_time_t(now);
-    std::tm utc_tm = *std::gmtime(&now_c);
+void Logger::endInline() {
+    asyncOutput.drain();
+    asyncEventOutput.drain();
+}
 
-    std::ostringstream oss;
-    oss << std::put_time(&utc_tm, "%Y-%m-%dT%H:%M:%SZ");
-    return oss.str();
+// Write stream health when due
+void Logger::idle() {
+    logStreamHealth(false);
 }
 
-std::string Logger::alertFlagsToString(const AlertFlags& flags){
-    std::ostringstream oss;
+void Logger::setStreamMonitor(StreamMonitor* monitor) {
+    streamMonitor = monitor;
+    healthOutput.open(directory + "/stream_health.csv", std::ios::out);
+    if (!healthOutput.is_open()) {
+        std::cerr << "[Logger] Error when trying to open stream health file" << std::endl;
+    } else {
+        healthOutput << "Timestamp,Seconds,Source,Received,Lost,Reordered,Duplicated,Malformed,"
+                     << "Jitter ms,Rate Hz,Idle s" << std::endl;
+    }
+}
 
+// Rows within the same wall second share one formatted timestamp
+const std::string& Logger::timestampOf(double time) {
+    const double second = std::floor(clock->getEpoch() + time);
+    if (second != timestampSecond) {
+        timestamp = clock->iso8601(time);
+        timestampSecond = second;
+    }
+    return timestamp;
+}
+
+void Logger::appendAlertFlags(std::string& out, const AlertFlags& flags){
     // Convert all flags to alert strings
-    if (flags.belowOperatingTemp)   oss << ",BELOW OP TEMP";
-    if (flags.aboveOperatingTemp)   oss << ",ABOVE OP TEMP";
-    if (flags.aboveAltitudeCeiling) oss << ",ABOVE ALT CEILING";
-    if (flags.stallSpeed) oss << ",STALL SPEED";
-    if (flags.overMaxSpeed) oss << ",OVER MAXSPEED";
-    if (flags.overSafeVerticalSpeed) oss << ",OVER SAFE VERTSPEED";
-    if (flags.lowEngineRPM) oss << ",LOW ENGINE RPM";
-    if (flags.highEngineRPM) oss << ",HIGH ENGINE RPM";
-    if (flags.highOilTemp) oss << ",HIGH OIL TEMP";
-    if (flags.lowOilPressure) oss << ",LOW OIL PRESSURE";
-    if (flags.highOilPressure) oss << ",HIGH OIL PRESSURE";
-    if (flags.lowFuel) oss << ",LOW FUEL";
-    if (flags.lowFuelFlow) oss << ",LOW FUEL FLOW";
-    if (flags.highFuelFlow) oss << ",HIGH FUEL FLOW";
-    if (flags.pitchExceeded) oss << ",PITCH";
-    if (flags.pitchRateExceeded) oss << ",PITCH RATE";
-    if (flags.rollExceeded) oss << ",ROLL";
-    if (flags.rollRateExceeded) oss << ",ROLL RATE";
-    if (flags.yawRateExceeded) oss << ",YAW RATE";
-    
-    //Return string
-    return oss.str();
+    uint32_t mask = toAlertMask(flags);
+    for (int i = 0; i < ALERT_COUNT; ++i) {
+        if (mask & (1u << i)) {
+            out += ',';
+            out += ALERT_NAMES[i];
+        }
+    }
+}
+
+void Logger::appendCustomAlerts(std::string& out, uint32_t customAlerts){
+    for (uint32_t bits = customAlerts; bits; bits &= bits - 1) {
+        std::size_t i = __builtin_ctz(bits);
+        if (i < customAlertNames.size()) {
+            out += ',';
+            out += customAlertNames[i];
+        }
+    }
+}
+
+void Logger::appendAnomalies(std::string& out, const AnomalyFlags& anomalies){
+    for (uint32_t bits = anomalies.any(); bits; bits &= bits - 1) {
+        int c = __builtin_ctz(bits);
+        if (anomalies.spike & (1u << c)) {
+            out += ",SPIKE ";
+            out += CHANNEL_NAMES[c];
+        }
+        if (anomalies.drift & (1u << c)) {
+            out += ",DRIFT ";
+            out += CHANNEL_NAMES[c];
+        }
+    }
+}
+
+// One row per sender with its running totals, every STREAM_HEALTH_PERIOD seconds
+void Logger::logStreamHealth(bool force) {
+    if (!streamMonitor || !healthOutput.is_open()) return;
+    const double now = streamMonitor->now();
+    if (!force && now - lastHealthRow < STREAM_HEALTH_PERIOD) return;
+    lastHealthRow = now;
+
+    const std::string rowTimestamp = clock->iso8601(clock->now());
+    char line[256];
+    for (int i = 0; i < streamMonitor->sourceCount(); ++i) {
+        StreamHealthStats st = streamMonitor->snapshot(i);
+        int n = std::snprintf(line, sizeof(line), ",%.3f,%s,%llu,%llu,%llu,%llu,%llu,%.3f,%.2f,%.3f\n",
+            now, st.label, (unsigned long long)st.received, (unsigned long long)st.lost,
+            (unsigned long long)st.reordered, (unsigned long long)st.duplicated,
+            (unsigned long long)st.malformed, st.jitterMs, st.rateHz, st.idleSeconds);
+        healthOutput << rowTimestamp;
+        healthOutput.write(line, n);
+    }
+    healthOutput.flush();
+}
+
+// Format the raise/clear events produced by the latest batch, stamped with their own time
+void Logger::formatAlertEvents(){
+    char line[128];
+    for (const AlertEvent& e : pendingEvents) {
+        int n = e.raised
+            ? std::snprintf(line, sizeof(line), ",%.3f,%s,RAISE,\n", e.time, ALERT_NAMES[e.alert])
+            : std::snprintf(line, sizeof(line), ",%.3f,%s,CLEAR,%.3f\n", e.time, ALERT_NAMES[e.alert], e.duration);
+        eventBuffer += timestampOf(e.time);
+        eventBuffer.append(line, n);
+    }
 }
 
 /*----------------------------------------------------------------------------------------
-Title: Logger::log
+Title: Logger::logBatch
 Description:
-Log function to log sensor data to a CSV file.
-@param data SensorData object containing the sensor readings
-This function appends the sensor data to a file named "sensor_log.csv" in CSV format.
-It includes the current timestamp in ISO 8601 format, and checks for specific thresholds
-for temperature, altitude, speed, vertical speed, engine RPM, oil temperature, 
-oil pressure, fuel capacity, fuel flow, pitch, and roll.
-If any of these thresholds are exceeded, an alert is added to the log entry.
+Log function to log a batch of sensor data to a CSV file.
+@param samples PipelineSamples with the sensor readings and the alerts the analyze stage raised
+@param count number of samples
+Every row is formatted into one reused buffer which is written to "sensor_log.csv" with a
+single write and flush per batch. Each row has the ISO 8601 timestamp of its sample (the
+clock's wall time at the sample's pipeline time, the same text on every --clock=virtual run),
+the readings and derived metrics to 2 decimals, the names of every alert (built-in and custom)
+raised for the sample and the channels the anomaly detector flagged, and GAP when a
+resampled row was held across an input gap.
+Alert transitions the AlertHistory produced since the last batch go to "alert_events.csv"
+the same way. In reactor mode both are appended for a writer thread instead (see beginInline).
 ----------------------------------------------------------------------------------------*/
-AlertFlags Logger::logSensorData(const SensorData& data) {
-    if (!output.is_open()) return AlertFlags{};
-    //std::cout << "[Logger] Logging data: Temp=" << data.temperature << ", Alt=" << data.altitude << std::endl;
-
-    //Create output file with sensor data in CSV format
-    output << get_iso8601_utc()                      // Get current time in ISO 8601 format
-           << std::fixed << std::setprecision(2)     // Set fixed-point notation to nearest 2nd dec 80.12
-           << "," << data.temperature
-           << "," << data.altitude               
-           << "," << data.speed
-           << "," << data.verticalSpeed
-           << "," << data.engineRPM << "," << data.throttle
-           << "," << data.oilPressure << "," << data.oilTemperature
-           << "," << data.fuelCap << "," << data.fuelFlow
-           << "," << data.pitch << "," << data.pitchRate
-           << "," << data.roll << "," << data.rollRate
-           << "," << data.yaw << "," << data.yawRate;             
-
-    AlertFlags alerts = AlertManager::evaluate(data);
-
-    // Print a newline at the end of the log entry
-    // std::endl flushes the output buffer making sure the log is displayed immediate
-    output << alertFlagsToString(alerts) << std::endl;
-    output.flush();
-
-    // Return alerts
-    return alerts;
-}// End of Logger::log
\ No newline at end of file
+void Logger::logBatch(const PipelineSample* samples, std::size_t count) {
+    // Only alert transitions go to the event log. They are taken from the history on
+    // every batch, even when sensor_log.csv could not be opened, so they never pile up
+    pendingEvents.clear();
+    if (history) history->takeEvents(pendingEvents);
+    if ((eventOutput.is_open() || asyncEventOutput.isOpen()) && !pendingEvents.empty()) {
+        eventBuffer.clear();
+        formatAlertEvents();
+        if (asyncEventOutput.isOpen()) {
+            asyncEventOutput.append(eventBuffer.data(), eventBuffer.size());
+        } else {
+            eventOutput.write(eventBuffer.data(), eventBuffer.size());
+            eventOutput.flush();
+        }
+    }
+
+    if ((!output.is_open() && !asyncOutput.isOpen()) || count == 0) return;
+
+    rowBuffer.clear();
+    char row[512];
+    for (std::size_t i = 0; i < count; ++i) {
+        const SensorData& data = samples[i].data;
+        const DerivedData& derived = samples[i].derived;
+
+        // Fixed-point notation to nearest 2nd dec 80.12
+        int n = std::snprintf(row, sizeof(row),
+            ",%.2f,%.2f,%.2f,%.2f,%.2f,%.2f,%.2f,%.2f,%.2f,%.2f,%.2f,%.2f,%.2f,%.2f,%.2f,%.2f"
+            ",%.2f,%.2f,%.2f,%.2f,%.2f",
+            data.temperature, data.altitude, data.speed, data.verticalSpeed,
+            data.engineRPM, data.throttle, data.oilPressure, data.oilTemperature,
+            data.fuelCap, data.fuelFlow, data.pitch, data.pitchRate,
+            data.roll, data.rollRate, data.yaw, data.yawRate,
+            derived.densityAltitude, derived.endurance, derived.range,
+            derived.climbGradient, derived.loadFactor);
+
+        rowBuffer += timestampOf(samples[i].time);
+        rowBuffer.append(row, n);
+        appendAlertFlags(rowBuffer, samples[i].alerts);
+        appendCustomAlerts(rowBuffer, samples[i].customAlerts);
+        appendAnomalies(rowBuffer, samples[i].anomalies);
+        if (samples[i].gap) rowBuffer += ",GAP";
+        rowBuffer += '\n';
+    }
+
+    // One write and flush for the whole batch, or one append for the writer thread in reactor mode
+    if (asyncOutput.isOpen()) {
+        asyncOutput.append(rowBuffer.data(), rowBuffer.size());
+    } else {
+        output.write(rowBuffer.data(), rowBuffer.size());
+        output.flush();
+    }
+
+    logStreamHealth(false);
+}// End of Logger::logBatch
\ No newline at end of file
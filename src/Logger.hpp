@@ -2,21 +2,90 @@
 
 #include "AlertFlags.hpp"
 #include "SensorData.hpp"
+#include "AlertHistory.hpp"
+#include "Pipeline.hpp"
+#include "StreamHealth.hpp"
+#include "Clock.hpp"
+#include "AsyncFileWriter.hpp"
 #include <string>
 #include <fstream>
 
-// Logger class to handle logging of sensor data
-class Logger {
+// Logger class to handle logging of sensor data, runs as the CSV sink of the pipeline
+class Logger : public Sink {
     public:
-        Logger();                  //Constructor 
+        explicit Logger(const std::string& directory = "data"); //Constructor, files go in directory
         ~Logger();                 //Deconstructor
 
-         // Function to log sensor data
-        AlertFlags logSensorData(const SensorData& data);
+        // Sink interface
+        const char* name() const override { return "csv"; }
+        void consume(const PipelineSample& sample) override { logSensorData(sample); }
+        void consumeBatch(const std::vector<PipelineSample>& batch) override {
+            logBatch(batch.data(), batch.size());
+        }
+        void idle() override;
+        // The flight record never drops rows, its queue grows while the disk is behind
+        OverflowPolicy overflowPolicy() const override { return OverflowPolicy::Grow; }
+
+        // --reactor: hand sensor_log.csv and alert_events.csv to writer threads so the
+        // reactor never waits for the disk, and wait for the last writes at the end
+        void beginInline() override;
+        void endInline() override;
+
+         // Function to log an evaluated sample
+        void logSensorData(const PipelineSample& sample) { logBatch(&sample, 1); }
+
+        // Serialize a batch of evaluated samples into one buffer and write it at once
+        void logBatch(const PipelineSample* samples, std::size_t count);
+
+        // Raise/clear history fed by the analyze stage, its events go to alert_events.csv
+        void setAlertHistory(AlertHistory* h) { history = h; }
+
+        // Names of the custom --rules alerts, logged like the built-in ones
+        void setCustomAlertNames(const std::vector<std::string>& names) { customAlertNames = names; }
+
+        // Clock the samples were stamped with, row timestamps are its wall time of each
+        // sample. Defaults to a real clock started with the logger
+        void setClock(Clock* c) { clock = c; }
+
+        // Write UDP stream health of every sender to stream_health.csv every few seconds
+        void setStreamMonitor(StreamMonitor* monitor);
+        static constexpr double STREAM_HEALTH_PERIOD = 5.0; // Seconds
+        static constexpr std::size_t WRITER_BEHIND_BYTES = 1024 * 1024; // Reactor CSV backlog reported at shutdown
         
     private:
         std::ofstream output;      // Output file stream for logging
+        std::ofstream eventOutput; // Alert raise/clear events only
+        std::ofstream healthOutput; // UDP stream health rows
+        AsyncFileWriter asyncOutput;      // sensor_log.csv in reactor mode, instead of output
+        AsyncFileWriter asyncEventOutput; // alert_events.csv in reactor mode, instead of eventOutput
+        std::string directory;
+        StreamMonitor* streamMonitor = nullptr;
+        RealClock defaultClock;
+        Clock* clock = &defaultClock;
+        double timestampSecond = -1.0;         // Wall second the cached timestamp is for
+        std::string timestamp;                 // ISO 8601 text of timestampSecond
+        std::vector<std::string> customAlertNames; // Index = PipelineSample::customAlerts bit
+        double lastHealthRow = 0.0;
+        AlertHistory* history = nullptr;
+        std::vector<AlertEvent> pendingEvents; // Reused between batches
+        std::string rowBuffer;                 // Reused between batches
+        std::string eventBuffer;               // Reused between batches
+        
+        // Append a stream health row per sender when due (always when force is set)
+        void logStreamHealth(bool force);
+
+        // ISO 8601 timestamp of a pipeline time, formatted once per wall second
+        const std::string& timestampOf(double time);
+
+        // Append alert transitions to the event buffer
+        void formatAlertEvents();
         
-        // Helper: convert AlertFlags to CSV alert string
-        std::string alertFlagsToString(const AlertFlags& flags);
+        // Helper: append AlertFlags as CSV alert string
+        void appendAlertFlags(std::string& out, const AlertFlags& flags);
+
+        // Helper: append the names of raised custom alerts
+        void appendCustomAlerts(std::string& out, uint32_t customAlerts);
+
+        // Helper: append flagged channels as "SPIKE <channel>" / "DRIFT <channel>"
+        void appendAnomalies(std::string& out, const AnomalyFlags& anomalies);
 };
\ No newline at end of file
@@ -0,0 +1,76 @@
+#include "PackedSample.hpp"
+#include <cmath>
+
+// Round to hundredths and saturate to the int16 range
+static int16_t toCenti(double value) {
+    double scaled = std::round(value * 100.0);
+    if (scaled > 32767.0) return 32767;
+    if (scaled < -32768.0) return -32768;
+    return static_cast<int16_t>(scaled);
+}
+
+static double fromCenti(int16_t value) {
+    return value / 100.0;
+}
+
+PackedSensorData packSensorData(const SensorData& d) {
+    PackedSensorData p;
+    p.altitude       = static_cast<float>(d.altitude);
+    p.agl            = static_cast<float>(d.agl);
+    p.verticalSpeed  = static_cast<float>(d.verticalSpeed);
+    p.engineRPM      = static_cast<float>(d.engineRPM);
+    p.yaw            = static_cast<float>(d.yaw);
+    p.temperature    = toCenti(d.temperature);
+    p.speed          = toCenti(d.speed);
+    p.throttle       = toCenti(d.throttle);
+    p.oilPressure    = toCenti(d.oilPressure);
+    p.oilTemperature = toCenti(d.oilTemperature);
+    p.fuelCap        = toCenti(d.fuelCap);
+    p.fuelFlow       = toCenti(d.fuelFlow);
+    p.pitch          = toCenti(d.pitch);
+    p.pitchRate      = toCenti(d.pitchRate);
+    p.roll           = toCenti(d.roll);
+    p.rollRate       = toCenti(d.rollRate);
+    p.yawRate        = toCenti(d.yawRate);
+    return p;
+}
+
+SensorData unpackSensorData(const PackedSensorData& p) {
+    SensorData d;
+    d.temperature    = fromCenti(p.temperature);
+    d.altitude       = p.altitude;
+    d.agl            = p.agl;
+    d.speed          = fromCenti(p.speed);
+    d.verticalSpeed  = p.verticalSpeed;
+    d.engineRPM      = p.engineRPM;
+    d.throttle       = fromCenti(p.throttle);
+    d.oilPressure    = fromCenti(p.oilPressure);
+    d.oilTemperature = fromCenti(p.oilTemperature);
+    d.fuelCap        = fromCenti(p.fuelCap);
+    d.fuelFlow       = fromCenti(p.fuelFlow);
+    d.pitch          = fromCenti(p.pitch);
+    d.pitchRate      = fromCenti(p.pitchRate);
+    d.roll           = fromCenti(p.roll);
+    d.rollRate       = fromCenti(p.rollRate);
+    d.yaw            = p.yaw;
+    d.yawRate        = fromCenti(p.yawRate);
+    return d;
+}
+
+PackedSample packSample(const PipelineSample& sample) {
+    PackedSample p;
+    p.seq = static_cast<uint32_t>(sample.seq);
+    p.timeMs = static_cast<uint32_t>(std::llround(sample.time * 1000.0));
+    p.data = packSensorData(sample.data);
+    p.alertMask = toAlertMask(sample.alerts);
+    return p;
+}
+
+PipelineSample unpackSample(const PackedSample& p) {
+    PipelineSample sample;
+    sample.seq = p.seq;
+    sample.time = p.timeMs / 1000.0;
+    sample.data = unpackSensorData(p.data);
+    sample.alerts = fromAlertMask(p.alertMask);
+    return sample;
+}
@@ -0,0 +1,63 @@
+#pragma once
+
+#include "SensorData.hpp"
+#include "PipelineSample.hpp"
+#include <cstdint>
+
+// Compact form of SensorData, 44 bytes instead of 136.
+// Channels that fit are stored as int16 hundredths (the 2 decimals Logger writes),
+// wide-range channels as float. Values outside an int16 range saturate.
+//
+//  Channel          Storage      Resolution         Range
+//  temperature      int16 x100   0.01 F             +-327.67 F
+//  altitude         float        <= 0.004 ft        below 65536 ft
+//  agl              float        <= 0.004 ft        below 65536 ft
+//  speed            int16 x100   0.01 kt            +-327.67 kt
+//  verticalSpeed    float        <= 0.001 fpm       below 16384 fpm
+//  engineRPM        float        <= 0.0005 rpm      below 4096 rpm
+//  throttle         int16 x100   0.01 %             +-327.67
+//  oilPressure      int16 x100   0.01 psi           +-327.67 psi
+//  oilTemperature   int16 x100   0.01 F             +-327.67 F
+//  fuelCap          int16 x100   0.01 gal           +-327.67 gal
+//  fuelFlow         int16 x100   0.01 gph           +-327.67 gph
+//  pitch/roll       int16 x100   0.01 deg           +-327.67 deg
+//  *Rate            int16 x100   0.01 deg/s         +-327.67 deg/s
+//  yaw              float        <= 0.00003 deg     any heading
+struct PackedSensorData {
+    float altitude;
+    float agl;
+    float verticalSpeed;
+    float engineRPM;
+    float yaw;
+    int16_t temperature;
+    int16_t speed;
+    int16_t throttle;
+    int16_t oilPressure;
+    int16_t oilTemperature;
+    int16_t fuelCap;
+    int16_t fuelFlow;
+    int16_t pitch;
+    int16_t pitchRate;
+    int16_t roll;
+    int16_t rollRate;
+    int16_t yawRate;
+};
+static_assert(sizeof(PackedSensorData) == 44, "PackedSensorData layout changed");
+
+// Compact evaluated sample for binary outputs, 56 bytes instead of 232.
+// Alerts are evaluated on the full precision sample before packing and travel as a
+// mask. Readers take the decision from that mask: a reading rounded next to a
+// threshold can land on the other side of it when evaluated again.
+struct PackedSample {
+    uint32_t seq;       // Low 32 bits of the pipeline sequence number
+    uint32_t timeMs;    // Milliseconds since the pipeline started (~49 days)
+    PackedSensorData data;
+    uint32_t alertMask; // toAlertMask bits
+};
+static_assert(sizeof(PackedSample) == 56, "PackedSample layout changed");
+
+// Conversions, unpack(pack(x)) matches x to the resolution in the table above
+PackedSensorData packSensorData(const SensorData& data);
+SensorData unpackSensorData(const PackedSensorData& packed);
+PackedSample packSample(const PipelineSample& sample);
+PipelineSample unpackSample(const PackedSample& packed);
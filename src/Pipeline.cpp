@@ -0,0 +1,151 @@
+#include "Pipeline.hpp"
+#include "ThreadControl.hpp"
+#include <iostream>
+
+// The sink's own policy, --lossless turns dropping into blocking
+static OverflowPolicy sinkPolicy(const PipelineConfig& config, const Sink& sink) {
+    const OverflowPolicy policy = sink.overflowPolicy();
+    return (config.lossless && policy == OverflowPolicy::DropOldest) ? OverflowPolicy::Block : policy;
+}
+
+// The input always blocks, a sample is never lost before it has been evaluated
+Pipeline::Pipeline(const PipelineConfig& config)
+: config(config), inputChannel(config.channelCapacity, OverflowPolicy::Block) {}
+
+Pipeline::~Pipeline() {
+    stop();
+}
+
+void Pipeline::addTransform(Transform transform) {
+    transforms.push_back(std::move(transform));
+}
+
+void Pipeline::addSink(Sink& sink) {
+    sinks.push_back(std::make_unique<SinkSlot>(sink, config.channelCapacity, sinkPolicy(config, sink)));
+}
+
+// Start the analyze thread and one thread per sink
+void Pipeline::start() {
+    if (started) return;
+    started = true;
+
+    for (auto& slot : sinks) {
+        SinkSlot* s = slot.get();
+        s->thread = std::thread([this, s] {
+            ThreadControl::applyToCurrentThread(ThreadRole::Logger, config.threads[(int)ThreadRole::Logger]);
+            sinkLoop(*s);
+        });
+    }
+
+    analyzeThread = std::thread([this] {
+        ThreadControl::applyToCurrentThread(ThreadRole::Analyze, config.threads[(int)ThreadRole::Analyze]);
+        analyzeLoop();
+    });
+}
+
+/*-------------------------------------------------------------------------------------
+// Title: Pipeline::stop
+// Description:
+// Shut the graph down front to back so nothing already ingested is lost: close the
+// input and let the analyze thread drain it, then close every sink channel and let
+// each sink drain its own backlog.
+-------------------------------------------------------------------------------------*/
+void Pipeline::stop() {
+    if (!started) return;
+    started = false;
+
+    inputChannel.close();
+    if (analyzeThread.joinable()) analyzeThread.join();
+
+    for (auto& slot : sinks) slot->channel.close();
+    for (auto& slot : sinks) {
+        if (slot->thread.joinable()) slot->thread.join();
+    }
+
+    // Report anything a sink could not keep up with
+    for (auto& slot : sinks) {
+        if (slot->channel.dropped() > 0) {
+            std::cerr << "[Pipeline] Sink '" << slot->sink.name() << "' dropped "
+                      << slot->channel.dropped() << " samples\n";
+        }
+        if (slot->channel.peakSize() > slot->channel.getCapacity()) {
+            std::cerr << "[Pipeline] Sink '" << slot->sink.name() << "' fell behind, queued up to "
+                      << slot->channel.peakSize() << " samples\n";
+        }
+    }
+    std::cout << "[Pipeline] Stopped.\n";
+}// End of stop
+
+/*-------------------------------------------------------------------------------------
+// Title: Pipeline::analyzeLoop
+// Description:
+// Drains everything pending on the input (up to maxBatch, waiting at most
+// maxBatchLatency for more) in one lock, runs every transform once over the batch,
+// then hands the evaluated batch to each sink's channel under one lock per sink.
+// Sink channels drop their oldest entries or grow when full, so this loop is never
+// held up by a sink unless --lossless is set.
+-------------------------------------------------------------------------------------*/
+void Pipeline::analyzeLoop() {
+    std::vector<PipelineSample> batch;
+    batch.reserve(config.maxBatch);
+    bool waited = false;
+    const auto maxWait = std::chrono::microseconds((long long)(config.maxBatchLatencyMs * 1000.0));
+
+    while (inputChannel.popBatch(batch, config.maxBatch, maxWait, &waited)) {
+        // Time from the producer's push to this thread running again
+        if (waited && maxWait.count() == 0) {
+            ThreadControl::jitter(ThreadRole::Analyze).record(inputChannel.sinceLastPush());
+        }
+
+        for (auto& transform : transforms) transform(batch);
+        for (auto& slot : sinks) slot->channel.pushBatch(batch);
+    }
+
+    std::cout << "[Pipeline] Data analysis stopped.\n";
+}// End of analyzeLoop
+
+// Feed one sink from its channel until the channel is closed and drained
+void Pipeline::sinkLoop(SinkSlot& slot) {
+    std::vector<PipelineSample> batch;
+    batch.reserve(config.maxBatch);
+    bool waited = false;
+
+    while (slot.channel.popBatch(batch, config.maxBatch, std::chrono::microseconds(0), &waited)) {
+        if (waited) ThreadControl::jitter(ThreadRole::Logger).record(slot.channel.sinceLastPush());
+
+        slot.sink.consumeBatch(batch);
+        slot.consumed.fetch_add(batch.size(), std::memory_order_relaxed);
+
+        if (slot.channel.size() == 0) slot.sink.idle();
+    }
+    slot.sink.idle();
+}
+
+void Pipeline::beginInline() {
+    for (auto& slot : sinks) slot->sink.beginInline();
+}
+
+void Pipeline::runInline(std::vector<PipelineSample>& batch) {
+    for (auto& transform : transforms) transform(batch);
+    for (auto& slot : sinks) {
+        slot->sink.consumeBatch(batch);
+        slot->consumed.fetch_add(batch.size(), std::memory_order_relaxed);
+    }
+}
+
+void Pipeline::idleInline() {
+    for (auto& slot : sinks) slot->sink.idle();
+}
+
+void Pipeline::endInline() {
+    for (auto& slot : sinks) slot->sink.endInline();
+}
+
+std::vector<SinkStatus> Pipeline::getSinkStatus() {
+    std::vector<SinkStatus> status;
+    for (auto& slot : sinks) {
+        status.push_back({slot->sink.name(), slot->channel.size(),
+                          slot->consumed.load(std::memory_order_relaxed), slot->channel.dropped()});
+    }
+    return status;
+}
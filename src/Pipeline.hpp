@@ -0,0 +1,94 @@
+#pragma once
+
+#include "PipelineSample.hpp"
+#include "Channel.hpp"
+#include "Config.hpp"
+#include <functional>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Consumer at the end of the graph (CSV, binary log, GUI...), runs on its own thread
+class Sink {
+public:
+    virtual ~Sink() = default;
+    virtual const char* name() const = 0;
+    virtual void consume(const PipelineSample& sample) = 0;
+    // Everything pending for this sink, override to write it in one go
+    virtual void consumeBatch(const std::vector<PipelineSample>& batch) {
+        for (const PipelineSample& sample : batch) consume(sample);
+    }
+    virtual void idle() {} // Channel ran empty, a good moment to flush buffers
+
+    // What the sink's channel does when it is full. Dropping by default; a sink that
+    // must not lose samples grows its queue instead, evaluation never waits on a sink
+    virtual OverflowPolicy overflowPolicy() const { return OverflowPolicy::DropOldest; }
+
+    // Reactor mode only, called on the reactor thread before the first and after the
+    // last runInline, so a sink can tie its I/O to that thread
+    virtual void beginInline() {}
+    virtual void endInline() {}
+};
+
+// In-place processing step run on every batch before fan-out (e.g. alert evaluation)
+using Transform = std::function<void(std::vector<PipelineSample>&)>;
+
+// Queue depth and drop count of one sink, for display
+struct SinkStatus {
+    std::string name;
+    std::size_t queued;
+    uint64_t consumed;
+    uint64_t dropped;
+};
+
+// Stage graph: sources -> input channel -> transforms (analyze thread) -> one bounded
+// channel and thread per sink. The input channel always blocks, so every ingested
+// sample is evaluated. A slow sink never delays evaluation or the other sinks: it drops
+// its own oldest samples, or for the CSV log queues past its capacity. --lossless makes
+// the dropping sinks block instead. Every stage drains its channel in batches of up to
+// maxBatch samples.
+class Pipeline {
+public:
+    explicit Pipeline(const PipelineConfig& config);
+    ~Pipeline();
+
+    // Sources push ingested samples here
+    BoundedChannel<PipelineSample>& input() { return inputChannel; }
+
+    // Graph setup, call before start()
+    void addTransform(Transform transform);
+    void addSink(Sink& sink);
+
+    void start();
+    void stop();  // Close the input, drain every stage and join all threads
+
+    // Reactor mode (instead of start/stop): run the transforms and every sink on the
+    // caller's thread, the input and sink channels are not used
+    void beginInline(); // Before the first runInline, on the same thread
+    void runInline(std::vector<PipelineSample>& batch);
+    void idleInline(); // Nothing arrived for a while, let sinks flush
+    void endInline();   // After the last runInline, sinks finish their writes
+
+    std::vector<SinkStatus> getSinkStatus();
+
+private:
+    struct SinkSlot {
+        SinkSlot(Sink& sink, std::size_t capacity, OverflowPolicy policy)
+        : sink(sink), channel(capacity, policy) {}
+        Sink& sink;
+        BoundedChannel<PipelineSample> channel;
+        std::thread thread;
+        std::atomic<uint64_t> consumed{0};
+    };
+
+    void analyzeLoop();
+    void sinkLoop(SinkSlot& slot);
+
+    PipelineConfig config;
+    BoundedChannel<PipelineSample> inputChannel;
+    std::vector<Transform> transforms;
+    std::vector<std::unique_ptr<SinkSlot>> sinks;
+    std::thread analyzeThread;
+    bool started = false;
+};
@@ -0,0 +1,20 @@
+#pragma once
+
+#include "SensorData.hpp"
+#include "DerivedData.hpp"
+#include "AlertFlags.hpp"
+#include "AnomalyFlags.hpp"
+#include <cstdint>
+
+// One sample as it moves through the pipeline: ingest fills seq/time/data,
+// the analyze stage fills in the evaluated results, sinks only read it
+struct PipelineSample {
+    uint64_t seq = 0;   // Ingest order, starts at 0
+    double time = 0.0;  // Seconds since the pipeline started, taken at ingest
+    SensorData data{};
+    DerivedData derived{}; // Filled by DerivedMetrics before alerts are evaluated
+    AlertFlags alerts{};
+    AnomalyFlags anomalies{};
+    bool gap = false;   // Resampled point across an input gap, values held (see Resampler)
+    uint32_t customAlerts = 0; // Custom --rules alerts, bit i is AlertRules::getCustomNames()[i]
+};
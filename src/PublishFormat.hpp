@@ -0,0 +1,23 @@
+#pragma once
+
+#include "PackedSample.hpp"
+#include <cstddef>
+#include <cstdint>
+
+// Datagram layout of the UDP rebroadcast (UdpPublisher -> tools/udp_subscriber).
+// Host byte order (little endian on x86):
+//   PublishHeader, then header.count PackedSample records (56 bytes each, alert mask included)
+// Several records share a datagram so a burst costs one send instead of one per sample.
+struct PublishHeader {
+    uint32_t magic;    // PUBLISH_MAGIC
+    uint16_t version;  // PUBLISH_VERSION
+    uint16_t count;    // Records that follow
+    uint32_t sequence; // Datagram counter per publisher, gaps = datagrams lost on the wire
+    uint32_t reserved;
+};
+static_assert(sizeof(PublishHeader) == 16, "PublishHeader layout changed");
+
+static constexpr uint32_t PUBLISH_MAGIC = 0x50323731;   // "172P"
+static constexpr uint16_t PUBLISH_VERSION = 1;
+static constexpr std::size_t PUBLISH_MAX_RECORDS = 24;  // 16 + 24 * 56 = 1360 bytes, fits a 1500 byte MTU
+static constexpr std::size_t PUBLISH_MAX_DATAGRAM = sizeof(PublishHeader) + PUBLISH_MAX_RECORDS * sizeof(PackedSample);
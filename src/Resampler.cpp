@@ -0,0 +1,89 @@
+#include "Resampler.hpp"
+#include <cmath>
+
+// Shortest signed difference between two headings
+static double wrapDegrees(double angle) {
+    if (angle > 180.0) return angle - 360.0;
+    if (angle < -180.0) return angle + 360.0;
+    return angle;
+}
+
+// Constructor
+Resampler::Resampler(double rateHz, double maxGap)
+: period(1.0 / rateHz), maxGap(maxGap) {
+    for (int c = 0; c < SENSOR_CHANNEL_COUNT; ++c) modes[c] = ResampleMode::Linear;
+}
+
+// Next grid point is the first multiple of the period at or after time
+void Resampler::restartGrid(double time) {
+    gridStart = std::ceil(time / period) * period;
+    gridIndex = 0;
+}
+
+// Append one grid point between before and after
+void Resampler::emit(const PipelineSample& before, const PipelineSample& after, double time, bool gap) {
+    output.emplace_back();
+    PipelineSample& out = output.back();
+    out.seq = nextSeq++;
+    out.time = time;
+    out.gap = gap;
+
+    const double* a = reinterpret_cast<const double*>(&before.data);
+    const double* b = reinterpret_cast<const double*>(&after.data);
+    double* v = reinterpret_cast<double*>(&out.data);
+    const double span = after.time - before.time;
+    const double f = (gap || span <= 0.0) ? 0.0 : (time - before.time) / span;
+    for (int c = 0; c < SENSOR_CHANNEL_COUNT; ++c) {
+        v[c] = modes[c] == ResampleMode::Linear ? a[c] + (b[c] - a[c]) * f : a[c];
+    }
+
+    // Yaw goes the short way round through +-180
+    if (modes[CH_YAW] == ResampleMode::Linear) {
+        v[CH_YAW] = wrapDegrees(a[CH_YAW] + wrapDegrees(b[CH_YAW] - a[CH_YAW]) * f);
+    }
+    if (gap) ++gapCount;
+}
+
+/*-------------------------------------------------------------------------------------
+// Title: Resampler::process
+// Description:
+// For every input sample, emit the grid points between the previous sample and it:
+// interpolated per channel mode, or held and marked as gap when the two are more
+// than maxGap apart. A sample with the same time as the previous one replaces it.
+// The grid points are built in a reused vector that is swapped with the batch, so
+// no allocation happens once both have grown to the largest batch.
+-------------------------------------------------------------------------------------*/
+void Resampler::process(std::vector<PipelineSample>& batch) {
+    output.clear();
+    for (const PipelineSample& sample : batch) {
+        ++inputCount;
+        if (!havePrevious) {
+            previous = sample;
+            havePrevious = true;
+            restartGrid(sample.time);
+            continue;
+        }
+        if (sample.time <= previous.time) { // Same instant (or clock step back), keep the newest values
+            previous.data = sample.data;
+            continue;
+        }
+
+        const double interval = sample.time - previous.time;
+        if (interval > MAX_GAP_FILL) {
+            // Too long to fill, start over and mark the first point after it
+            restartGrid(sample.time);
+            restarted = true;
+        }
+
+        const bool gap = interval > maxGap;
+        for (double t = gridStart + gridIndex * period; t <= sample.time; t = gridStart + gridIndex * period) {
+            // A point right on the sample has a real reading
+            if (t == sample.time) emit(sample, sample, t, restarted);
+            else emit(previous, sample, t, gap || restarted);
+            restarted = false;
+            ++gridIndex;
+        }
+        previous = sample;
+    }
+    batch.swap(output);
+}// End of Resampler::process
@@ -0,0 +1,54 @@
+#pragma once
+
+#include "PipelineSample.hpp"
+#include <cstdint>
+#include <vector>
+
+// How a channel is filled in between two input samples
+enum class ResampleMode : uint8_t {
+    Linear, // Straight line between the samples either side of the grid point
+    Hold    // Zero-order hold, the last value at or before the grid point
+};
+
+// First transform of the analyze stage with --resample=<hz>. Turns samples that arrive
+// at irregular times (FlightGear datagrams, 500 ms random mode) into a uniform grid
+// at multiples of 1/rate seconds, so every later stage and sink sees evenly spaced
+// data. Incremental: only the last input sample is kept, a grid point is produced as
+// soon as the sample after it arrives.
+// When two input samples are more than maxGap apart, the grid points between them hold
+// the older values and are marked as gap instead of being interpolated. A gap longer
+// than MAX_GAP_FILL seconds restarts the grid at the next sample instead of filling it.
+class Resampler {
+public:
+    static constexpr double MAX_GAP_FILL = 60.0; // Seconds
+
+    Resampler(double rateHz, double maxGap);
+
+    // Channels that are held instead of interpolated (all linear by default)
+    void setMode(int channel, ResampleMode mode) { modes[channel] = mode; }
+
+    // Replace batch with the grid points its samples complete
+    void process(std::vector<PipelineSample>& batch);
+
+    uint64_t getInputCount() const { return inputCount; }
+    uint64_t getOutputCount() const { return nextSeq; }
+    uint64_t getGapCount() const { return gapCount; } // Grid points marked as gap
+
+private:
+    double period;
+    double maxGap;
+    ResampleMode modes[SENSOR_CHANNEL_COUNT];
+
+    bool havePrevious = false;
+    PipelineSample previous;  // Last input sample
+    double gridStart = 0.0;   // Grid time of gridIndex 0
+    uint64_t gridIndex = 0;   // Next grid point is gridStart + gridIndex * period
+    bool restarted = false;   // Grid restarted after a long gap, next point is marked
+    uint64_t nextSeq = 0;     // Sequence numbers of the output
+    uint64_t inputCount = 0;
+    uint64_t gapCount = 0;
+    std::vector<PipelineSample> output; // Swapped with the batch, reused
+
+    void restartGrid(double time);
+    void emit(const PipelineSample& before, const PipelineSample& after, double time, bool gap);
+};
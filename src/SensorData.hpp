@@ -1,5 +1,7 @@
 #pragma once
 
+#include <cstddef>
+
 // Struct to hold sensor data for Cessna 172 Skyhawk simulation
 struct SensorData {
     double temperature;    // Temperature in Farenheit
@@ -19,4 +21,37 @@ struct SensorData {
     double rollRate;       // Roll angle rate in degrees per second
     double yaw;            // Yaw angle in degrees (optional, not used in the original code)
     double yawRate;        // Yaw angle rate in degrees per second (optional, not used in the original code)
-};
\ No newline at end of file
+};
+
+// Index of each SensorData field when the struct is read as an array of doubles,
+// used by code that handles every channel the same way (history rollups, ...)
+enum SensorChannel {
+    CH_TEMPERATURE, CH_ALTITUDE, CH_AGL, CH_SPEED, CH_VERTICAL_SPEED,
+    CH_ENGINE_RPM, CH_THROTTLE, CH_OIL_PRESSURE, CH_OIL_TEMPERATURE,
+    CH_FUEL_CAP, CH_FUEL_FLOW, CH_PITCH, CH_PITCH_RATE, CH_ROLL, CH_ROLL_RATE,
+    CH_YAW, CH_YAW_RATE,
+    SENSOR_CHANNEL_COUNT
+};
+static_assert(sizeof(SensorData) == SENSOR_CHANNEL_COUNT * sizeof(double), "SensorData must be plain doubles");
+static_assert(offsetof(SensorData, yawRate) == CH_YAW_RATE * sizeof(double), "SensorChannel order must match SensorData");
+
+// Log names for each channel, index is the SensorChannel
+inline const char* const CHANNEL_NAMES[SENSOR_CHANNEL_COUNT] = {
+    "TEMPERATURE", "ALTITUDE", "AGL", "SPEED", "VERTSPEED",
+    "ENGINE RPM", "THROTTLE", "OIL PRESSURE", "OIL TEMP",
+    "FUEL", "FUEL FLOW", "PITCH", "PITCH RATE", "ROLL", "ROLL RATE",
+    "YAW", "YAW RATE"
+};
+
+// Field name of each channel as typed in rule files and on the command line
+inline const char* const CHANNEL_IDENTIFIERS[SENSOR_CHANNEL_COUNT] = {
+    "temperature", "altitude", "agl", "speed", "verticalSpeed",
+    "engineRPM", "throttle", "oilPressure", "oilTemperature",
+    "fuelCap", "fuelFlow", "pitch", "pitchRate", "roll", "rollRate",
+    "yaw", "yawRate"
+};
+
+// Channel value by index
+inline double channelValue(const SensorData& data, int channel) {
+    return reinterpret_cast<const double*>(&data)[channel];
+}
\ No newline at end of file
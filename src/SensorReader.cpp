@@ -1,4 +1,7 @@
 #include "SensorReader.hpp"
+#include "FGDecoder.hpp"
+#include "ThreadControl.hpp"
+#include <algorithm>
 #include <random>
 #include <thread>
 #include <chrono>
@@ -6,13 +9,24 @@
 #include <ws2tcpip.h>
 #include <iostream>
 #include <cstdlib>
-#include <sstream>
-#include <vector>
-#include <functional>
 
 // SensorReader class constructor
-SensorReader::SensorReader(Logger& logger, const std::string& mode, std::atomic<bool>& running) 
-: logger(logger), mode(mode), running(running) {}
+SensorReader::SensorReader(BoundedChannel<PipelineSample>& output, const PipelineConfig& config, std::atomic<bool>& running,
+                           Clock& clock, StreamMonitor* streamMonitor)
+: output(output), clock(clock), config(config), running(running), streamMonitor(streamMonitor) {}
+
+PipelineSample SensorReader::stamp(const SensorData& data) {
+    PipelineSample sample;
+    sample.seq = nextSeq++;
+    sample.time = clock.now();
+    sample.data = data;
+    return sample;
+}
+
+// Push one sample into the pipeline's input channel
+void SensorReader::publish(const SensorData& data) {
+    output.push(stamp(data));
+}
 
 /*-------------------------------------------------------------------------------------
 // Title: SensorReader::generateData
@@ -21,36 +35,40 @@ SensorReader::SensorReader(Logger& logger, const std::string& mode, std::atomic<
 // This function checks the mode of operation and calls the appropriate data generation method.
 -------------------------------------------------------------------------------------*/
 void SensorReader::generateData() {
-    std::cout << "[SensorReader] Starting data gen in mode: " << mode << std::endl;
+    std::cout << "[SensorReader] Starting data gen in mode: " << config.mode << std::endl;
     // If the mode is "random", it generates random sensor data.
-    if(mode == "random"){
+    if(config.mode == "random"){
         generateRandomData();
     }
     // If the mode is "flightgear", it generates data from FlightGear.
-    else if(mode == "flightgear"){
+    else if(config.mode == "flightgear"){
         generateFGData();
     }
     // If the mode is neither "random" nor "flightgear", it prints an error message.
     else {
-        std::cerr << "[SensorReader] Unknown mode: " << mode << "Please use 'random' or 'flightgear'.\n";
-        return;
+        std::cerr << "[SensorReader] Unknown mode: " << config.mode << "Please use 'random' or 'flightgear'.\n";
     }
+
 }// End of generateData
 
 /*-------------------------------------------------------------------------------------
 // Title: SensorReader::generateRandomData
 // Description:
-// Generate random sensor data and push it to a queue for analysis for testing purposes.
+// Generate random sensor data and push it to the pipeline for analysis for testing purposes.
 // This function simulates the generation of sensor data for a Cessna 172 Skyhawk.
 // It uses random number generation to create values for temperature, altitude, speed,
 // vertical speed, engine RPM, fuel flow, pitch, and roll.
-// The generated data is pushed to a queue, which can be processed by another thread.
+// The generated data is pushed to the pipeline's input channel, which is processed by
+// the analyze thread. The generator is seeded with --seed (or a random seed, printed
+// so the run can be repeated) and paced by the clock, so with a virtual clock the
+// same seed and --duration give the same samples at the same times on every run.
 -------------------------------------------------------------------------------------*/
 void SensorReader::generateRandomData() {
     // Create a random number generator and distributions for sensor data
     // This will generate random values for temperature, altitude, speed, etc.
-    std::random_device rd;
-    std::mt19937 gen(rd());
+    const uint32_t seed = config.hasSeed ? config.seed : std::random_device{}();
+    std::cout << "[SensorReader] Random seed " << seed << ", " << clock.name() << " clock" << std::endl;
+    std::mt19937 gen(seed);
     std::uniform_real_distribution<> tempDist(-20.0, 50.0);
     std::uniform_real_distribution<> altDist(0.0, 15000.0);
     std::uniform_real_distribution<> aglDist(5.0, 6.0);
@@ -69,8 +87,8 @@ void SensorReader::generateRandomData() {
     std::uniform_real_distribution<> yawDist(-180.0, 180.0);
     std::uniform_real_distribution<> yawRateDist(-30.0, 30.0);
 
-    // Log data in an infinite loop
-    while (running) {
+    // Log data until stopped or the requested duration has passed
+    while (running && (config.duration <= 0.0 || clock.now() < config.duration)) {
         SensorData data = {
             tempDist(gen),
             altDist(gen), aglDist(gen),
@@ -82,33 +100,66 @@ void SensorReader::generateRandomData() {
             rollDist(gen), rollRateDist(gen),
             yawDist(gen), yawRateDist(gen)
         };
-        // Push the generated data to the queue
-        {
-            // Lock the mutex to ensure thread-safe access to the queue
-            std::lock_guard<std::mutex> lock(mtx);
-            // Push data to queue
-            dataQueue.push(data);
-        }
-        // Notify the analyzer thread that new data is available
-        // This will wake up the analyzer thread if it is waiting
-        cv.notify_one();
-        std::this_thread::sleep_for(std::chrono::milliseconds(500));
+        // Push the generated data to the pipeline, this wakes the analyze thread
+        publish(data);
+
+        // Sleep to the next period and record how late the wake-up was (in clock time)
+        const double wakeAt = clock.now() + RANDOM_PERIOD;
+        clock.sleepUntil(wakeAt);
+        ThreadControl::jitter(ThreadRole::Ingest).record(clock.now() - wakeAt);
     }
 }// End of generateData
 
 /*-------------------------------------------------------------------------------------
 // Title: SensorReader::generateFGData
 // Description:
-// Generate sensor data from FlightGear and push it to a queue for analysis.
+// Generate sensor data from FlightGear and push it to the pipeline for analysis.
 // This function reads sensor data from a FlightGear thru a UDP port and pushes 
-// it to a queue. It uses a simple parser to extract the sensor data.
+// it to the pipeline. Datagrams are decoded as text (sensor.xml) or binary (sensor_bin.xml)
+// depending on the --protocol option FlightGear was configured with. Every datagram is
+// also accounted in the stream monitor of its sender (loss, reorder, jitter, rate).
 -------------------------------------------------------------------------------------*/
 void SensorReader::generateFGData() {
+    SOCKET udpSocket = openFGSocket();
+    if (udpSocket == INVALID_SOCKET) return;
+
+    // Receive and process incoming UDP packets
+    char buffer[1024];
+    sockaddr_in senderAddr;
+    int senderAddrSize = sizeof(senderAddr);
+    
+    while(running){
+        // Receive data from the socket    
+        int bytesReceived = recvfrom(udpSocket, buffer, sizeof(buffer) - 1, 0,
+                                     (SOCKADDR*)&senderAddr, &senderAddrSize);
+                                     
+        //std::cout << "[DEBUG] Received " << bytesReceived << " bytes from FlightGear\n";
+
+        // IF the receive operation wasn't successful
+        if (bytesReceived == SOCKET_ERROR) {
+            std::cerr << "[SensorReader] recvform failed!" << std::endl;
+            break;
+        }
+        
+        SensorData data{};
+        if (decodeDatagram(buffer, bytesReceived, senderAddr, data)) {
+            publish(data);
+        }
+    }
+
+    // Close the socket and clean up Winsock
+    closesocket(udpSocket);
+    WSACleanup();
+    std::cout << "[SensorReader] Stopped receiving FlightGear data.\n";
+}// End of generateFGData
+
+// Start Winsock and bind a UDP socket to the configured port
+SOCKET SensorReader::openFGSocket() {
     // Initialize Winsock
     WSADATA wsaData;
     if (WSAStartup(MAKEWORD(2,2), &wsaData) != 0) {
         std::cerr << "WSAStartup failed" << std::endl;
-        return;
+        return INVALID_SOCKET;
     }
 
     // Create a UDP socket
@@ -116,154 +167,149 @@ void SensorReader::generateFGData() {
     if (udpSocket == INVALID_SOCKET) {
         std::cerr << "Socket creation failed" << std::endl;
         WSACleanup();
-        return;
+        return INVALID_SOCKET;
     }
 
-    // Bind the socket to port 5500
+    // Bind the socket to the configured port (5500 by default)
     sockaddr_in recvAddr{};
     recvAddr.sin_family = AF_INET;
-    recvAddr.sin_port = htons(5500); // Must match FlightGear output port
+    recvAddr.sin_port = htons(config.port); // Must match FlightGear output port
     recvAddr.sin_addr.s_addr = INADDR_ANY;
 
     // Bind the socket to the address and port
-    // This allows the socket to listen for incoming UDP packets on port 5500
+    // This allows the socket to listen for incoming UDP packets on the port
     // If the bind operation fails, print an error message and clean up
     if (bind(udpSocket, (SOCKADDR*)&recvAddr, sizeof(recvAddr)) == SOCKET_ERROR) {
         std::cerr << "Bind failed" << std::endl;
         closesocket(udpSocket);
         WSACleanup();
-        return;
+        return INVALID_SOCKET;
     }
 
-    std::cout << "Listening for UDP data on port 5500..." << std::endl;
+    std::cout << "Listening for " << (config.fgFormat == FGFormat::Binary ? "binary" : "text")
+              << " UDP data on port " << config.port << "..." << std::endl;
+    return udpSocket;
+}
 
-    // Receive and process incoming UDP packets
-    char buffer[1024];
-    sockaddr_in senderAddr;
-    int senderAddrSize = sizeof(senderAddr);
-    
-    while(running){
-        // Receive data from the socket    
-        int bytesReceived = recvfrom(udpSocket, buffer, sizeof(buffer) - 1, 0,
-                                     (SOCKADDR*)&senderAddr, &senderAddrSize);
-                                     
-        //std::cout << "[DEBUG] Received " << bytesReceived << " bytes from FlightGear\n";
-
-        // IF the receive operation wasn't successful
-        if (bytesReceived == SOCKET_ERROR) {
-            std::cerr << "[SensorReader] recvform failed!" << std::endl;
-            break;
-        }
-        
+// Decode a datagram in the format FlightGear was started with. Every datagram is also
+// accounted in the stream monitor of its sender (loss, reorder, jitter, rate).
+bool SensorReader::decodeDatagram(char* buffer, int bytes, const sockaddr_in& sender, SensorData& data) {
+    StreamStamp stamp;
+    bool decoded = false;
+    if (config.fgFormat == FGFormat::Binary) {
+        // Fixed layout, decoded straight from the receive buffer
+        decoded = FGDecoder::parseBinary(buffer, bytes, data, &stamp);
+    } else {
         // Null-terminate the received data to make it a valid string
-        buffer[bytesReceived] = '\0';
+        buffer[bytes] = '\0';
         std::string line(buffer);
         //std::cout << "[DEBUG] Received: " << line << std::endl;
-
-        // Parse the received data line
-        SensorData data{};
-        if(parseFGData(line, data)) {
-            std::lock_guard<std::mutex> lock(mtx);
-            dataQueue.push(data);
-            cv.notify_one();
-            
-            //std::cout << "[gFGData] Data Queue Size: " << dataQueue.size() << "\n";
-        }
+        decoded = FGDecoder::parseText(line, data, &stamp);
     }
 
-    // Close the socket and clean up Winsock
-    closesocket(udpSocket);
-    WSACleanup();
-    std::cout << "[SensorReader] Stopped receiving FlightGear data.\n";
-}// End of generateFGData
+    // Stream health of the sender
+    if (streamMonitor) {
+        SourceHealth& health = streamMonitor->source(sender.sin_addr.s_addr, sender.sin_port);
+        if (decoded) health.onPacket(stamp, streamMonitor->now());
+        else health.onMalformed(streamMonitor->now());
+    }
+    return decoded;
+}
 
 /*-------------------------------------------------------------------------------------
-// Title: SensorReader::parseFGData
+// Title: SensorReader::runFGReactor
 // Description:
-// Parse a line of FlightGear data and extract sensor values.
-// This function takes a line of data from FlightGear, splits it by tabs, and extracts
-// the sensor values into a SensorData structure. It returns true if parsing is successful,
-// or false if the line is malformed.
+// Single thread alternative to generateFGData + the analyze and sink threads, for
+// machines with few cores. Waits in WSAPoll until the socket is readable, then
+// drains every pending datagram with non-blocking recvfrom, decodes and stamps them
+// into one batch and runs the pipeline's transforms and sinks on it inline. Like the
+// analyze thread, a batch is run once it has --max-batch samples or its first sample
+// is --max-batch-latency-ms old, so a trickle of single datagrams can still share one
+// log write. Sinks get their idle() call when the socket has been quiet for a poll period.
+// The CSV sink hands its writes to a writer thread (Logger::beginInline), so a slow
+// disk does not hold up reading the socket. Receiving is still one recvfrom call per
+// datagram, registered I/O (RIOReceive/RIODequeueCompletion) is not used.
 -------------------------------------------------------------------------------------*/
-bool SensorReader::parseFGData(const std::string& line, SensorData& data) {
-    bool parsed = false;             // Initialize parsed flag to false
-    std::istringstream stream(line); // Create a string stream from the line
-    std::string token;               // Variable to hold each token
+void SensorReader::runFGReactor(Pipeline& pipeline) {
+    SOCKET udpSocket = openFGSocket();
+    if (udpSocket == INVALID_SOCKET) return;
 
-    // Define handlers for each prefix
-    static const std::vector<std::pair<std::string, std::function<void(const std::string&)>>> handlers = {
-        {"TF=", [&](const std::string& val) { data.temperature = std::stof(val); }},
-        {"A=",  [&](const std::string& val) { data.altitude = std::stof(val); }},
-        {"AGL=", [&](const std::string& val) { data.agl = std::stof(val); }},
-        {"V=",  [&](const std::string& val) { data.speed = std::stof(val); }},
-        {"VSF=", [&](const std::string& val) { data.verticalSpeed = std::stof(val) * 60; }},
-        {"ER=", [&](const std::string& val) { data.engineRPM = std::stof(val); }},
-        {"T=",  [&](const std::string& val) { data.throttle = std::stof(val); }},
-        {"OP=", [&](const std::string& val) { data.oilPressure = std::stof(val); }},
-        {"OT=", [&](const std::string& val) { data.oilTemperature = std::stof(val); }},
-        {"FCG=", [&](const std::string& val) { data.fuelCap = std::stof(val); }},
-        {"FFG=", [&](const std::string& val) { data.fuelFlow = std::stof(val); }},
-        {"PA=", [&](const std::string& val) { data.pitch = std::stof(val); }},
-        {"PR=", [&](const std::string& val) { data.pitchRate = std::stof(val); }},
-        {"RA=", [&](const std::string& val) { data.roll = std::stof(val); }},
-        {"RR=", [&](const std::string& val) { data.rollRate = std::stof(val); }},
-        {"YA=", [&](const std::string& val) { data.yaw = std::stof(val); }},
-        {"YR=", [&](const std::string& val) { data.yawRate = std::stof(val); }},
-    };
+    u_long nonBlocking = 1;
+    if (ioctlsocket(udpSocket, FIONBIO, &nonBlocking) == SOCKET_ERROR) {
+        std::cerr << "[SensorReader] Could not make the socket non-blocking" << std::endl;
+        closesocket(udpSocket);
+        WSACleanup();
+        return;
+    }
 
-    while (stream >> token) {
-        for (const auto& [prefix, handler] : handlers) {
-            if (token.rfind(prefix, 0) == 0) {
-                try {
-                    handler(token.substr(prefix.size()));
-                    parsed = true;
-                } catch (const std::exception& e) {
-                    std::cerr << "Failed to parse token: " << token << " (" << e.what() << ")\n";
-                }
-                break;
+    WSAPOLLFD pollFd{};
+    pollFd.fd = udpSocket;
+    pollFd.events = POLLRDNORM;
+    std::vector<PipelineSample> batch;
+    batch.reserve(config.maxBatch);
+    char buffer[1024];
+    sockaddr_in senderAddr;
+    pipeline.beginInline();
+    using SteadyClock = std::chrono::steady_clock;
+    const auto maxLatency = std::chrono::microseconds((long long)(config.maxBatchLatencyMs * 1000.0));
+    SteadyClock::time_point batchStart;
+
+    while (running) {
+        // Short timeout so a stop request is noticed and sinks get their idle call,
+        // shorter while a partial batch is waiting for its deadline
+        int timeoutMs = 100;
+        if (!batch.empty()) {
+            auto left = std::chrono::duration_cast<std::chrono::milliseconds>(batchStart + maxLatency - SteadyClock::now());
+            timeoutMs = (int)std::max<long long>(0, std::min<long long>(timeoutMs, left.count()));
+        }
+        int ready = WSAPoll(&pollFd, 1, timeoutMs);
+        if (ready == SOCKET_ERROR) {
+            std::cerr << "[SensorReader] WSAPoll failed: " << WSAGetLastError() << std::endl;
+            break;
+        }
+        if (ready == 0) {
+            if (!batch.empty()) {
+                pipeline.runInline(batch);
+                batch.clear();
+            } else {
+                pipeline.idleInline();
             }
+            continue;
         }
-    }
-    
-    // If any of the expected fields were parsed, return true
-    return parsed;
-}// End of parseFGData
 
-/*-------------------------------------------------------------------------------------
-// Title: SensorReader::analyzeData
-// Description:
-// Analyze the sensor data by logging it to a file.
-// This function continuously checks the queue for new sensor data,
-// retrieves it, and logs it using the Logger class.
---------------------------------------------------------------------------------------*/
-void SensorReader::analyzeData() {
-    // Wait for data to be available in the queue or for the running flag to be false
-    while (running || !dataQueue.empty()) {
-        // Wait for data to be available in the queue
-        std::unique_lock<std::mutex> lock(mtx);
-        cv.wait(lock, [this] { return !dataQueue.empty() || !running; });
-        
-        // If running is false and the queue is empty, exit the loop
-        while (!dataQueue.empty()) {
-            //Get data from queue
-            SensorData data = dataQueue.front();
-            //Pop data from queue
-            dataQueue.pop();
-            //std::cout << "[analyzeData] Data Queue Size: " << dataQueue.size() << "\n";
-            // Unlock mutex
-            lock.unlock();  // Allow generateData to keep pushing while logging
-            // Log the data
-            AlertFlags alerts = logger.logSensorData(data);
-            // Log to GUI
-            {
-                std::lock_guard<std::mutex> latestDataLock(dataMutex);
-                latestData = data;
-                latestAlerts = alerts;
+        // Drain what is queued on the socket into the batch
+        bool failed = false;
+        while (batch.size() < config.maxBatch) {
+            int senderAddrSize = sizeof(senderAddr);
+            int bytesReceived = recvfrom(udpSocket, buffer, sizeof(buffer) - 1, 0,
+                                         (SOCKADDR*)&senderAddr, &senderAddrSize);
+            if (bytesReceived == SOCKET_ERROR) {
+                int error = WSAGetLastError();
+                if (error == WSAEWOULDBLOCK) break;       // Drained
+                if (error == WSAECONNRESET) continue;     // ICMP from an earlier send, harmless
+                std::cerr << "[SensorReader] recvfrom failed: " << error << std::endl;
+                failed = true;
+                break;
+            }
+
+            SensorData data{};
+            if (decodeDatagram(buffer, bytesReceived, senderAddr, data)) {
+                if (batch.empty()) batchStart = SteadyClock::now();
+                batch.push_back(stamp(data));
             }
-            // Re-lock the mutex
-            lock.lock();
         }
+
+        if (!batch.empty() && (failed || batch.size() >= config.maxBatch || SteadyClock::now() - batchStart >= maxLatency)) {
+            pipeline.runInline(batch);
+            batch.clear();
+        }
+        if (failed) break;
     }
+    if (!batch.empty()) pipeline.runInline(batch);
+    pipeline.idleInline(); // Let sinks flush
+    pipeline.endInline();  // and wait for their last writes on this thread
 
-    std::cout << "[SensorReader] Data analysis stopped.\n";
-}// End of analyzeDatap
\ No newline at end of file
+    closesocket(udpSocket);
+    WSACleanup();
+    std::cout << "[SensorReader] Stopped receiving FlightGear data.\n";
+}// End of runFGReactor
\ No newline at end of file
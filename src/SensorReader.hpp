@@ -1,44 +1,51 @@
 #pragma once
 #include "SensorData.hpp"
-#include "AlertFlags.hpp"
-#include "Logger.hpp"
-#include <queue>
-#include <mutex>
-#include <condition_variable>
+#include "PipelineSample.hpp"
+#include "Channel.hpp"
+#include "Config.hpp"
+#include "StreamHealth.hpp"
+#include "Pipeline.hpp"
+#include "Clock.hpp"
+#include <winsock2.h>
 #include <atomic>
+#include <chrono>
 #include <string>
 
+// Source stage of the pipeline: produces samples from the random generator or FlightGear
 class SensorReader {
 public:
-    SensorReader(Logger& logger,
-                 const std::string& mode,
-                 std::atomic<bool>& running);
+    SensorReader(BoundedChannel<PipelineSample>& output,
+                 const PipelineConfig& config,
+                 std::atomic<bool>& running,
+                 Clock& clock,
+                 StreamMonitor* streamMonitor = nullptr);
     void generateData();
-    void generateRandomData();
+    void generateRandomData();          // Until stopped or --duration seconds of clock time
+    static constexpr double RANDOM_PERIOD = 0.5; // Seconds between random samples
     void generateFGData();
-    void analyzeData();
 
-    SensorData getLatestData(){
-        std::lock_guard<std::mutex> latestDataLock(dataMutex);
-        return latestData;
-    }
-    AlertFlags getLatestAlerts(){
-        std::lock_guard<std::mutex> latestDataLock(dataMutex);
-        return latestAlerts;
-    }
+    // --reactor: one thread polls the non-blocking socket, drains every pending datagram
+    // and runs the pipeline's transforms and sinks inline on the batch (no hand-off)
+    void runFGReactor(Pipeline& pipeline);
 
 private:
-    SensorData latestData;
-    AlertFlags latestAlerts;
-
-    bool parseFGData(const std::string& line, SensorData& data);
-    std::queue<SensorData> dataQueue;
-    std::mutex mtx;
-    std::mutex dataMutex;
-    
-    std::condition_variable cv;
-    
-    Logger& logger;
-    std::string mode;          // Mode of operation: "random" or "flightgear"
+    // Stamp a sample with its sequence number and ingest time
+    PipelineSample stamp(const SensorData& data);
+
+    // Stamp a sample and hand it downstream
+    void publish(const SensorData& data);
+
+    // Winsock setup shared by both FlightGear loops, INVALID_SOCKET on failure
+    SOCKET openFGSocket();
+
+    // Decode one datagram in the configured format and account it to its sender
+    bool decodeDatagram(char* buffer, int bytes, const sockaddr_in& sender, SensorData& data);
+
+    BoundedChannel<PipelineSample>& output; // Input channel of the pipeline
+    uint64_t nextSeq = 0;
+    Clock& clock;                           // Stamps samples, paces the random generator
+
+    PipelineConfig config;      // Mode of operation ("random" or "flightgear") and options
     std::atomic<bool>& running; // Control variable for thread execution
+    StreamMonitor* streamMonitor; // Per-sender UDP health, optional
 };
\ No newline at end of file
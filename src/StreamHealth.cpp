@@ -0,0 +1,165 @@
+#include "StreamHealth.hpp"
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+
+// Relaxed increment, there is a single writer
+static void bump(std::atomic<uint64_t>& counter, uint64_t by = 1) {
+    counter.store(counter.load(std::memory_order_relaxed) + by, std::memory_order_relaxed);
+}
+
+void SourceHealth::onMalformed(double arrival) {
+    bump(malformed);
+    lastArrival.store(arrival, std::memory_order_relaxed);
+}
+
+/*-------------------------------------------------------------------------------------
+// Title: SourceHealth::onPacket
+// Description:
+// Account one decoded datagram. With a sequence number, gaps count as lost and
+// late packets as reordered (or duplicated when already seen in the last 64). With
+// only the sender clock, the same is judged from the sim time: a step several times
+// the usual period is a gap, an earlier time is reordered, the same time a duplicate.
+// Packets without a stamp only feed the rate and jitter.
+-------------------------------------------------------------------------------------*/
+void SourceHealth::onPacket(const StreamStamp& stamp, double arrival) {
+    bump(received);
+
+    if (stamp.hasSeq) trackSequence(stamp.seq);
+    else if (stamp.hasTime) trackSenderTime(stamp.simTime);
+    trackJitter(stamp, arrival);
+
+    // Effective rate, refreshed once a second
+    ++rateCount;
+    if (rateMark == 0.0) rateMark = arrival;
+    if (arrival - rateMark >= 1.0) {
+        rateHz.store(rateCount / (arrival - rateMark), std::memory_order_relaxed);
+        rateMark = arrival;
+        rateCount = 0;
+    }
+    lastArrival.store(arrival, std::memory_order_relaxed);
+    started = true;
+}// End of onPacket
+
+void SourceHealth::trackSequence(uint64_t seq) {
+    if (!started) {
+        highestSeq = seq;
+        window = 1;
+        return;
+    }
+    if (seq > highestSeq) {
+        uint64_t gap = seq - highestSeq;
+        if (gap > 1) bump(lost, gap - 1);
+        window = gap >= 64 ? 1 : (window << gap) | 1;
+        highestSeq = seq;
+        return;
+    }
+
+    uint64_t age = highestSeq - seq;
+    if (age < 64 && (window >> age) & 1) {
+        bump(duplicated);
+        return;
+    }
+    // Late, it was counted as lost when the gap opened
+    bump(reordered);
+    if (age < 64) {
+        window |= uint64_t(1) << age;
+        uint64_t l = lost.load(std::memory_order_relaxed);
+        if (l > 0) lost.store(l - 1, std::memory_order_relaxed);
+    }
+}
+
+void SourceHealth::trackSenderTime(double simTime) {
+    if (!started) {
+        lastSimTime = simTime;
+        return;
+    }
+    double step = simTime - lastSimTime;
+    if (step == 0.0) {
+        bump(duplicated);
+        return;
+    }
+    if (step < 0.0) {
+        bump(reordered);
+        // Late packet from the latest gap, it was counted as lost
+        if (gapMissing > 0 && simTime > gapStart) {
+            --gapMissing;
+            uint64_t l = lost.load(std::memory_order_relaxed);
+            if (l > 0) lost.store(l - 1, std::memory_order_relaxed);
+        }
+        return;
+    }
+
+    // Learn the usual step from steps that aren't gaps
+    gapMissing = 0;
+    if (period == 0.0 || step < 1.5 * period) {
+        period = period == 0.0 ? step : period + (step - period) / 16.0;
+    } else {
+        double missing = std::floor(step / period + 0.5) - 1.0;
+        if (missing > 0.0) {
+            bump(lost, (uint64_t)missing);
+            gapStart = lastSimTime;
+            gapMissing = (uint64_t)missing;
+        }
+    }
+    lastSimTime = simTime;
+}
+
+// Interarrival jitter, RFC 3550 6.4.1: smoothed |difference in transit time|.
+// Without a sender clock the deviation from the mean inter-arrival time is used.
+void SourceHealth::trackJitter(const StreamStamp& stamp, double arrival) {
+    if (started) {
+        double interArrival = arrival - prevArrival;
+        double d;
+        if (stamp.hasTime) {
+            d = interArrival - (stamp.simTime - prevSimTime);
+        } else {
+            meanInterArrival += (interArrival - meanInterArrival) / 16.0;
+            d = interArrival - meanInterArrival;
+        }
+        jitter += (std::fabs(d) - jitter) / 16.0;
+        jitterMs.store(jitter * 1000.0, std::memory_order_relaxed);
+    }
+    prevArrival = arrival;
+    prevSimTime = stamp.simTime;
+}
+
+StreamHealthStats SourceHealth::snapshot(double now) const {
+    StreamHealthStats s;
+    std::memcpy(s.label, label, sizeof(s.label));
+    s.received = received.load(std::memory_order_relaxed);
+    s.lost = lost.load(std::memory_order_relaxed);
+    s.reordered = reordered.load(std::memory_order_relaxed);
+    s.duplicated = duplicated.load(std::memory_order_relaxed);
+    s.malformed = malformed.load(std::memory_order_relaxed);
+    s.jitterMs = jitterMs.load(std::memory_order_relaxed);
+    s.rateHz = rateHz.load(std::memory_order_relaxed);
+    s.idleSeconds = now - lastArrival.load(std::memory_order_relaxed);
+    return s;
+}
+
+// Constructor
+StreamMonitor::StreamMonitor() : startTime(std::chrono::steady_clock::now()) {}
+
+double StreamMonitor::now() const {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+}
+
+// Find or add the slot of a sender. The label is written before the count is
+// published, so readers never see a slot half set up.
+SourceHealth& StreamMonitor::source(uint32_t address, uint16_t port) {
+    const uint64_t key = (uint64_t(address) << 16) | port;
+    const int n = count.load(std::memory_order_relaxed);
+    for (int i = 0; i < n; ++i) {
+        if (sources[i].key == key) return sources[i];
+    }
+    if (n == MAX_SOURCES) return sources[MAX_SOURCES - 1];
+
+    SourceHealth& s = sources[n];
+    s.key = key;
+    const unsigned char* a = reinterpret_cast<const unsigned char*>(&address);
+    const unsigned char* p = reinterpret_cast<const unsigned char*>(&port);
+    std::snprintf(s.label, sizeof(s.label), "%u.%u.%u.%u:%u", a[0], a[1], a[2], a[3], (p[0] << 8) | p[1]);
+    count.store(n + 1, std::memory_order_release);
+    return s;
+}
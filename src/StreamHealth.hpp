@@ -0,0 +1,79 @@
+#pragma once
+
+#include "FGDecoder.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+// Copy of one source's counters for display and logging
+struct StreamHealthStats {
+    char label[32];       // "a.b.c.d:port"
+    uint64_t received;    // Datagrams that decoded
+    uint64_t lost;        // Gaps in the sequence / sender clock
+    uint64_t reordered;   // Arrived after a newer packet
+    uint64_t duplicated;  // Same sequence / sender time seen again
+    uint64_t malformed;   // Failed to decode
+    double jitterMs;      // RFC 3550 style inter-arrival jitter
+    double rateHz;        // Decoded datagrams per second over the last second
+    double idleSeconds;   // Since the last datagram
+};
+
+// Health of one UDP sender. Only the receive thread updates it; counters are relaxed
+// atomics so the GUI and logger can read them at any time without a lock.
+class SourceHealth {
+public:
+    // Receive thread
+    void onPacket(const StreamStamp& stamp, double arrival);
+    void onMalformed(double arrival);
+
+    StreamHealthStats snapshot(double now) const;
+
+private:
+    friend class StreamMonitor;
+    uint64_t key = 0;
+    char label[32] = {};
+
+    std::atomic<uint64_t> received{0}, lost{0}, reordered{0}, duplicated{0}, malformed{0};
+    std::atomic<double> jitterMs{0.0}, rateHz{0.0}, lastArrival{0.0};
+
+    // Receive thread only
+    void trackSequence(uint64_t seq);
+    void trackSenderTime(double simTime);
+    void trackJitter(const StreamStamp& stamp, double arrival);
+    bool started = false;
+    uint64_t highestSeq = 0;
+    uint64_t window = 0;          // Bit i = highestSeq - i was seen
+    double lastSimTime = 0.0;
+    double period = 0.0;          // Typical sender clock step, for loss from time gaps
+    double gapStart = 0.0;        // Sender time before the latest gap
+    uint64_t gapMissing = 0;      // Packets of that gap still counted as lost
+    double prevArrival = 0.0;
+    double prevSimTime = 0.0;
+    double meanInterArrival = 0.0;
+    double jitter = 0.0;          // Seconds
+    double rateMark = 0.0;
+    uint64_t rateCount = 0;
+};
+
+// Stream health of every UDP sender the reader has heard from
+class StreamMonitor {
+public:
+    static constexpr int MAX_SOURCES = 8; // Later senders share the last slot
+
+    StreamMonitor();
+
+    // Receive thread: slot for a sender (IPv4 address and port in network order)
+    SourceHealth& source(uint32_t address, uint16_t port);
+
+    // Seconds since the monitor was created, the time base for arrivals
+    double now() const;
+
+    // Any thread
+    int sourceCount() const { return count.load(std::memory_order_acquire); }
+    StreamHealthStats snapshot(int index) const { return sources[index].snapshot(now()); }
+
+private:
+    SourceHealth sources[MAX_SOURCES];
+    std::atomic<int> count{0};
+    std::chrono::steady_clock::time_point startTime;
+};
@@ -0,0 +1,191 @@
+#include "ThreadControl.hpp"
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <pthread.h>
+#include <sched.h>
+#include <sys/mman.h>
+#include <cerrno>
+#include <cstring>
+#endif
+#include <iostream>
+#include <iomanip>
+
+// One jitter slot per role
+static JitterStats jitterStats[THREAD_ROLE_COUNT];
+
+// Set once --rt has raised the priority class and timer resolution
+static std::atomic<bool> processRaised{false};
+#ifdef _WIN32
+// Priority class the process had before --rt, put back by restoreProcess
+static DWORD savedPriorityClass = NORMAL_PRIORITY_CLASS;
+#endif
+
+const char* threadRoleName(ThreadRole role) {
+    switch (role) {
+        case ThreadRole::Ingest:  return "ingest";
+        case ThreadRole::Analyze: return "analyze";
+        case ThreadRole::Logger:  return "logger";
+        case ThreadRole::GUI:     return "gui";
+        default:                  return "unknown";
+    }
+}
+
+void JitterStats::record(double lateSeconds) {
+    // Waking early (negative lateness) counts as on time
+    uint64_t ns = lateSeconds > 0.0 ? (uint64_t)(lateSeconds * 1e9) : 0;
+    samples.fetch_add(1, std::memory_order_relaxed);
+    sumNs.fetch_add(ns, std::memory_order_relaxed);
+
+    uint64_t prev = maxNs.load(std::memory_order_relaxed);
+    while (ns > prev && !maxNs.compare_exchange_weak(prev, ns, std::memory_order_relaxed)) {}
+}
+
+double JitterStats::meanUs() const {
+    uint64_t n = count();
+    return n ? (sumNs.load(std::memory_order_relaxed) / (double)n) / 1000.0 : 0.0;
+}
+
+/*-------------------------------------------------------------------------------------
+// Title: ThreadControl::applyToCurrentThread
+// Description:
+// Pin the calling thread to the CPUs in affinityMask and, when realtime is set, raise
+// it to THREAD_PRIORITY_TIME_CRITICAL (the Windows counterpart of SCHED_FIFO). The
+// process is moved to HIGH_PRIORITY_CLASS so the boost is meaningful, and the system
+// timer is set to 1 ms so timed sleeps wake on time. If time-critical is refused the
+// thread falls back to THREAD_PRIORITY_HIGHEST, and then to normal priority.
+// Non-Windows builds (benchmarks) use pthread affinity and SCHED_FIFO instead.
+-------------------------------------------------------------------------------------*/
+#ifdef _WIN32
+void ThreadControl::applyToCurrentThread(ThreadRole role, const ThreadSettings& settings) {
+    const char* name = threadRoleName(role);
+    HANDLE thread = GetCurrentThread();
+
+    // CPU affinity
+    if (settings.affinityMask != 0) {
+        if (SetThreadAffinityMask(thread, (DWORD_PTR)settings.affinityMask) == 0) {
+            std::cerr << "[ThreadControl] " << name << ": affinity 0x" << std::hex
+                      << settings.affinityMask << std::dec << " rejected (" << GetLastError() << ")\n";
+        } else {
+            std::cout << "[ThreadControl] " << name << ": pinned to mask 0x" << std::hex
+                      << settings.affinityMask << std::dec << "\n";
+        }
+    }
+
+    if (!settings.realtime) return;
+
+    // Process class and timer resolution only need to be raised once
+    if (!processRaised.exchange(true)) {
+        const DWORD current = GetPriorityClass(GetCurrentProcess());
+        if (current != 0) savedPriorityClass = current;
+        if (!SetPriorityClass(GetCurrentProcess(), HIGH_PRIORITY_CLASS)) {
+            std::cerr << "[ThreadControl] Could not raise process priority class (" << GetLastError() << ")\n";
+        }
+        timeBeginPeriod(1);
+    }
+
+    // Thread priority with fallback
+    if (SetThreadPriority(thread, THREAD_PRIORITY_TIME_CRITICAL)) {
+        std::cout << "[ThreadControl] " << name << ": time-critical priority\n";
+    } else if (SetThreadPriority(thread, THREAD_PRIORITY_HIGHEST)) {
+        std::cerr << "[ThreadControl] " << name << ": time-critical refused, using highest priority\n";
+    } else {
+        std::cerr << "[ThreadControl] " << name << ": priority change refused, staying at normal\n";
+    }
+}// End of applyToCurrentThread
+#else
+void ThreadControl::applyToCurrentThread(ThreadRole role, const ThreadSettings& settings) {
+    const char* name = threadRoleName(role);
+    pthread_t thread = pthread_self();
+
+    // CPU affinity
+    if (settings.affinityMask != 0) {
+        cpu_set_t cpus;
+        CPU_ZERO(&cpus);
+        for (int i = 0; i < 64 && i < CPU_SETSIZE; ++i) {
+            if (settings.affinityMask & ((uint64_t)1 << i)) CPU_SET(i, &cpus);
+        }
+        int err = pthread_setaffinity_np(thread, sizeof(cpus), &cpus);
+        if (err != 0) {
+            std::cerr << "[ThreadControl] " << name << ": affinity 0x" << std::hex
+                      << settings.affinityMask << std::dec << " rejected (" << std::strerror(err) << ")\n";
+        } else {
+            std::cout << "[ThreadControl] " << name << ": pinned to mask 0x" << std::hex
+                      << settings.affinityMask << std::dec << "\n";
+        }
+    }
+
+    if (!settings.realtime) return;
+
+    // SCHED_FIFO needs CAP_SYS_NICE, stay on the default scheduler without it
+    sched_param param{};
+    param.sched_priority = sched_get_priority_max(SCHED_FIFO) - 1;
+    int err = pthread_setschedparam(thread, SCHED_FIFO, &param);
+    if (err == 0) {
+        std::cout << "[ThreadControl] " << name << ": SCHED_FIFO priority " << param.sched_priority << "\n";
+    } else {
+        std::cerr << "[ThreadControl] " << name << ": SCHED_FIFO refused (" << std::strerror(err)
+                  << "), staying at normal\n";
+    }
+}// End of applyToCurrentThread
+#endif
+
+/*-------------------------------------------------------------------------------------
+// Title: ThreadControl::lockMemory
+// Description:
+// Windows has no mlockall, the closest is raising the minimum working set so the
+// memory manager does not trim the pipeline's pages while it runs.
+-------------------------------------------------------------------------------------*/
+bool ThreadControl::lockMemory(std::size_t lockMB) {
+#ifndef _WIN32
+    // mlockall pins everything mapped now and later, the size is not needed
+    (void)lockMB;
+    if (mlockall(MCL_CURRENT | MCL_FUTURE) != 0) {
+        std::cerr << "[ThreadControl] mlockall failed (" << std::strerror(errno) << "), continuing unlocked\n";
+        return false;
+    }
+    std::cout << "[ThreadControl] Locked process memory\n";
+    return true;
+#else
+    SIZE_T minBytes = (SIZE_T)lockMB * 1024 * 1024;
+    SIZE_T maxBytes = minBytes * 2;
+    if (!SetProcessWorkingSetSize(GetCurrentProcess(), minBytes, maxBytes)) {
+        std::cerr << "[ThreadControl] Could not lock " << lockMB << " MB working set ("
+                  << GetLastError() << "), continuing unlocked\n";
+        return false;
+    }
+    std::cout << "[ThreadControl] Locked " << lockMB << " MB working set\n";
+    return true;
+#endif
+}// End of lockMemory
+
+// Pairs the timeBeginPeriod(1) of applyToCurrentThread and puts back the priority
+// class the process was started with
+void ThreadControl::restoreProcess() {
+    if (!processRaised.exchange(false)) return;
+#ifdef _WIN32
+    timeEndPeriod(1);
+    SetPriorityClass(GetCurrentProcess(), savedPriorityClass);
+#endif
+}
+
+JitterStats& ThreadControl::jitter(ThreadRole role) {
+    return jitterStats[static_cast<int>(role)];
+}
+
+void ThreadControl::printJitterReport() {
+    std::cout << "[ThreadControl] Scheduling jitter (late wake-ups):\n";
+    for (int i = 0; i < THREAD_ROLE_COUNT; ++i) {
+        const JitterStats& j = jitterStats[i];
+        std::cout << "  " << std::left << std::setw(8) << threadRoleName(static_cast<ThreadRole>(i)) << std::right;
+        if (j.count() == 0) {
+            // FlightGear ingest blocks on the socket, there is no deadline to be late for
+            std::cout << " not measured" << (i == (int)ThreadRole::Ingest
+                ? " (FlightGear ingest wakes on datagrams, arrival jitter is in stream_health.csv)" : "") << "\n";
+            continue;
+        }
+        std::cout << " samples=" << j.count()
+                  << std::fixed << std::setprecision(1)
+                  << " mean=" << j.meanUs() << "us max=" << j.maxUs() << "us\n";
+    }
+}
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+// Pipeline threads that can be placed and prioritised
+enum class ThreadRole { Ingest, Analyze, Logger, GUI, Count }; // Logger = every sink thread
+static constexpr int THREAD_ROLE_COUNT = static_cast<int>(ThreadRole::Count);
+
+// Name used on the command line and in reports
+const char* threadRoleName(ThreadRole role);
+
+// Requested placement for one thread
+struct ThreadSettings {
+    uint64_t affinityMask = 0; // Bit n = may run on CPU n, 0 = leave to the OS
+    bool realtime = false;     // Ask for time-critical priority, falls back to highest
+};
+
+// Scheduling jitter of one thread: how late it woke up compared to when it should have.
+// Lock free so it can be recorded from the hot path and read from the GUI.
+class JitterStats {
+public:
+    void record(double lateSeconds);
+
+    uint64_t count() const { return samples.load(std::memory_order_relaxed); }
+    double meanUs() const;
+    double maxUs() const { return maxNs.load(std::memory_order_relaxed) / 1000.0; }
+
+private:
+    std::atomic<uint64_t> samples{0};
+    std::atomic<uint64_t> sumNs{0};
+    std::atomic<uint64_t> maxNs{0};
+};
+
+class ThreadControl {
+public:
+    // Apply affinity and priority to the calling thread. Failures are reported and
+    // the thread keeps running with whatever could be applied.
+    static void applyToCurrentThread(ThreadRole role, const ThreadSettings& settings);
+
+    // Undo the process-wide changes --rt made (1 ms timer resolution, priority class), call at shutdown
+    static void restoreProcess();
+
+    // Keep at least lockMB of the process resident so it is not paged out
+    static bool lockMemory(std::size_t lockMB);
+
+    // Jitter collected for a role
+    static JitterStats& jitter(ThreadRole role);
+
+    // Print per-thread jitter to stdout, roles with no timed wake-ups show as not measured
+    static void printJitterReport();
+};
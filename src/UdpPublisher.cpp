@@ -0,0 +1,101 @@
+#include "UdpPublisher.hpp"
+#include <ws2tcpip.h>
+#include <cstring>
+#include <iostream>
+
+/*-------------------------------------------------------------------------------------
+// Title: UdpPublisher::UdpPublisher
+// Description:
+// Open a UDP socket aimed at address:port. For a multicast group (224.0.0.0 -
+// 239.255.255.255) the TTL is set so the stream can leave the host when asked to, and
+// loopback is enabled so subscribers on this machine receive it too. On failure the
+// sink stays closed and drops everything it is given.
+-------------------------------------------------------------------------------------*/
+UdpPublisher::UdpPublisher(const std::string& address, int port, int ttl) {
+    WSADATA wsaData;
+    if (WSAStartup(MAKEWORD(2,2), &wsaData) != 0) {
+        std::cerr << "[UdpPublisher] WSAStartup failed" << std::endl;
+        return;
+    }
+    winsockStarted = true;
+
+    destination.sin_family = AF_INET;
+    destination.sin_port = htons(port);
+    if (inet_pton(AF_INET, address.c_str(), &destination.sin_addr) != 1) {
+        std::cerr << "[UdpPublisher] Invalid address: " << address << std::endl;
+        return;
+    }
+
+    udpSocket = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+    if (udpSocket == INVALID_SOCKET) {
+        std::cerr << "[UdpPublisher] Socket creation failed" << std::endl;
+        return;
+    }
+
+    const unsigned char firstOctet = reinterpret_cast<const unsigned char*>(&destination.sin_addr)[0];
+    if (firstOctet >= 224 && firstOctet <= 239) {
+        DWORD hops = ttl;
+        DWORD loop = 1;
+        setsockopt(udpSocket, IPPROTO_IP, IP_MULTICAST_TTL, (const char*)&hops, sizeof(hops));
+        setsockopt(udpSocket, IPPROTO_IP, IP_MULTICAST_LOOP, (const char*)&loop, sizeof(loop));
+    }
+
+    // Room for a burst of full datagrams while the stack drains
+    int sendBuffer = 256 * 1024;
+    setsockopt(udpSocket, SOL_SOCKET, SO_SNDBUF, (const char*)&sendBuffer, sizeof(sendBuffer));
+
+    std::cout << "[UdpPublisher] Publishing to " << address << ":" << port << std::endl;
+}
+
+// Deconstructor
+UdpPublisher::~UdpPublisher() {
+    if (udpSocket != INVALID_SOCKET) {
+        closesocket(udpSocket);
+        std::cout << "[UdpPublisher] Sent " << getDatagramsSent() << " datagrams, "
+                  << getSendErrors() << " send errors" << std::endl;
+    }
+    if (winsockStarted) WSACleanup();
+}
+
+void UdpPublisher::consume(const PipelineSample& sample) {
+    publish(&sample, 1);
+}
+
+void UdpPublisher::consumeBatch(const std::vector<PipelineSample>& batch) {
+    publish(batch.data(), batch.size());
+}
+
+/*-------------------------------------------------------------------------------------
+// Title: UdpPublisher::publish
+// Description:
+// Pack the samples into datagrams of up to PUBLISH_MAX_RECORDS records, each with its
+// own sequence number, and send each with one sendto. A batch never waits for more
+// samples, the last datagram is sent partly filled.
+-------------------------------------------------------------------------------------*/
+void UdpPublisher::publish(const PipelineSample* samples, std::size_t count) {
+    if (udpSocket == INVALID_SOCKET) return;
+
+    while (count > 0) {
+        const std::size_t n = count < PUBLISH_MAX_RECORDS ? count : PUBLISH_MAX_RECORDS;
+
+        PublishHeader header{};
+        header.magic = PUBLISH_MAGIC;
+        header.version = PUBLISH_VERSION;
+        header.count = static_cast<uint16_t>(n);
+        header.sequence = nextSequence++;
+        std::memcpy(datagram, &header, sizeof(header));
+
+        PackedSample* records = reinterpret_cast<PackedSample*>(datagram + sizeof(header));
+        for (std::size_t i = 0; i < n; ++i) records[i] = packSample(samples[i]);
+
+        const int length = static_cast<int>(sizeof(header) + n * sizeof(PackedSample));
+        if (sendto(udpSocket, datagram, length, 0, (const SOCKADDR*)&destination, sizeof(destination)) == SOCKET_ERROR) {
+            sendErrors.fetch_add(1, std::memory_order_relaxed);
+        } else {
+            datagramsSent.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        samples += n;
+        count -= n;
+    }
+}// End of publish
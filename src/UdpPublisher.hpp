@@ -0,0 +1,38 @@
+#pragma once
+
+#include "Pipeline.hpp"
+#include "PublishFormat.hpp"
+#include <winsock2.h>
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Sink rebroadcasting every evaluated sample over UDP (unicast or multicast group)
+// in the PublishFormat.hpp layout, for dashboards and recorders on the network.
+class UdpPublisher : public Sink {
+public:
+    UdpPublisher(const std::string& address, int port, int ttl);
+    ~UdpPublisher();
+
+    bool isOpen() const { return udpSocket != INVALID_SOCKET; }
+
+    const char* name() const override { return "udp publish"; }
+    void consume(const PipelineSample& sample) override;
+    void consumeBatch(const std::vector<PipelineSample>& batch) override;
+
+    uint64_t getDatagramsSent() const { return datagramsSent.load(std::memory_order_relaxed); }
+    uint64_t getSendErrors() const { return sendErrors.load(std::memory_order_relaxed); }
+
+private:
+    // Pack samples into as few datagrams as possible and send them
+    void publish(const PipelineSample* samples, std::size_t count);
+
+    SOCKET udpSocket = INVALID_SOCKET;
+    sockaddr_in destination{};
+    uint32_t nextSequence = 0;
+    bool winsockStarted = false;
+    alignas(8) char datagram[PUBLISH_MAX_DATAGRAM]; // Reused for every send
+    std::atomic<uint64_t> datagramsSent{0};
+    std::atomic<uint64_t> sendErrors{0};
+};
@@ -1,6 +1,19 @@
 #include "SensorReader.hpp"
 #include "Logger.hpp"
+#include "BinaryLogger.hpp"
+#include "UdpPublisher.hpp"
+#include "BlackBox.hpp"
+#include "DerivedMetrics.hpp"
+#include "AlertManager.hpp"
+#include "AlertRules.hpp"
+#include "AnomalyDetector.hpp"
+#include "Resampler.hpp"
+#include "FlightSummary.hpp"
+#include "Pipeline.hpp"
 #include "GUI.hpp"
+#include "Config.hpp"
+#include "Clock.hpp"
+#include "ThreadControl.hpp"
 #include <GLFW/glfw3.h>
 #include <thread>
 #include <windows.h>
@@ -9,6 +22,7 @@
 #include <fstream>
 #include <atomic>
 #include <csignal>
+#include <memory>
 
 // Global atomic variable to control the running state of the threads
 std::atomic<bool> running(true);
@@ -23,49 +37,139 @@ int main(int argc, char* argv[]){
     //Prevent sys sleep
     SetThreadExecutionState(ES_CONTINUOUS | ES_SYSTEM_REQUIRED | ES_DISPLAY_REQUIRED);
     
-    //Init gui
-    GUI gui;
-    if (!gui.init()) return -1;
-    
-    // Check if the correct number of arguments is provided
-    if (argc < 2) {
-        // Print usage instructions if no arguments are provided
-        std::cerr << "Usage: " << argv[0] << " [random|flightgear]" << std::endl;
-        return 1;
-    }
-    
-    // Check the argument to determine the mode of operation
-    std::string mode = argv[1];
-    if (mode != "random" && mode != "flightgear") {
-        // Print error message if not flightgear or random
-        std::cerr << "Invalid mode. Use 'flightgear' or 'random'" << std::endl;
-        return 1;
+    // Parse mode of operation and options
+    PipelineConfig config;
+    if (!parseConfig(argc, argv, config)) return 1;
+
+    // Optional alert rules, compiled once before anything starts
+    AlertRules alertRules; // Only evaluated by the analyze thread
+    const bool useRules = !config.rulesFile.empty();
+    if (useRules && !alertRules.load(config.rulesFile)) return 1;
+
+    // Optional UDP rebroadcast, a target that can't be used stops here like --rules
+    std::unique_ptr<UdpPublisher> publisher;
+    if (!config.publishAddress.empty()) {
+        publisher = std::make_unique<UdpPublisher>(config.publishAddress, config.publishPort, config.publishTtl);
+        if (!publisher->isOpen()) {
+            std::cerr << "Could not publish to " << config.publishAddress << ":" << config.publishPort << std::endl;
+            return 1;
+        }
     }
 
+    // Pipeline time for every stage, real unless --clock says otherwise
+    std::unique_ptr<Clock> clock = makeClock(config.clockMode, config.clockScale);
+
+    //Init gui, unless running headless
+    GUI gui;
+    if (!config.headless && !gui.init(config)) return -1;
+
     // Register signal handler for graceful shutdown
     std::signal(SIGINT, signalHandler);
 
-    // Initialize the logger and sensor reader
+    // UDP health of every FlightGear sender, outlives the logger that reports it
+    StreamMonitor streamMonitor;
+    const bool udpSource = (config.mode == "flightgear");
+
+    // Sinks, each one runs on its own pipeline thread
     Logger logger;
-    SensorReader reader(logger, mode, running); //Gets data from flightgear or random gen
-
-    // Create threads for generating and analyzing sensor data
-    std::thread sensorThread(&SensorReader::generateData, &reader);
-    // Create a thread for analyzing sensor data
-    std::thread analyzerThread(&SensorReader::analyzeData, &reader);
-
-    // Render gui
-    while(!glfwWindowShouldClose(gui.window)){
-        gui.setLatestData(reader.getLatestData(), reader.getLatestAlerts());
-        gui.render();
-        std::this_thread::sleep_for(std::chrono::milliseconds(16));
+    logger.setClock(clock.get());
+    if (udpSource) logger.setStreamMonitor(&streamMonitor);
+    std::unique_ptr<BinaryLogger> binaryLogger;
+    if (config.binaryLog != BinaryLogFormat::Off) binaryLogger = std::make_unique<BinaryLogger>(config.binaryLog);
+    std::unique_ptr<BlackBox> blackBox;
+    if (config.blackboxMask != 0) {
+        blackBox = std::make_unique<BlackBox>(config.blackboxMask, config.blackboxPre, config.blackboxPost,
+                                              config.blackboxMaxMB);
     }
+    AlertHistory alertHistory; // Fed by the analyze thread, read by the summary, logger and GUI
+    logger.setAlertHistory(&alertHistory);
+    gui.setAlertHistory(&alertHistory);
+    logger.setCustomAlertNames(alertRules.getCustomNames());
+    gui.setCustomAlertNames(alertRules.getCustomNames());
+
+    // Stage graph: ingest -> [resample] -> derive metrics, evaluate alerts and anomalies once -> fan out to every sink
+    Pipeline pipeline(config);
+    std::unique_ptr<Resampler> resampler; // Only touched by the analyze thread
+    if (config.resampleHz > 0.0) {
+        resampler = std::make_unique<Resampler>(config.resampleHz, config.resampleGap);
+        for (int c = 0; c < SENSOR_CHANNEL_COUNT; ++c) {
+            if (config.resampleHoldMask & (1u << c)) resampler->setMode(c, ResampleMode::Hold);
+        }
+        pipeline.addTransform([r = resampler.get()](std::vector<PipelineSample>& batch) {
+            r->process(batch);
+        });
+    }
+    pipeline.addTransform([](std::vector<PipelineSample>& batch) {
+        DerivedMetrics::compute(batch.data(), batch.size());
+    });
+    if (useRules) {
+        pipeline.addTransform([&alertRules](std::vector<PipelineSample>& batch) {
+            alertRules.evaluate(batch.data(), batch.size());
+        });
+    } else {
+        pipeline.addTransform([](std::vector<PipelineSample>& batch) {
+            AlertManager::evaluate(batch.data(), batch.size());
+        });
+    }
+    AnomalyDetector anomalyDetector; // Only touched by the analyze thread
+    pipeline.addTransform([&anomalyDetector](std::vector<PipelineSample>& batch) {
+        anomalyDetector.process(batch.data(), batch.size());
+    });
+    pipeline.addTransform([&alertHistory](std::vector<PipelineSample>& batch) {
+        alertHistory.process(batch.data(), batch.size());
+    });
+    FlightSummary flightSummary(alertHistory); // Fed by the analyze thread, read by the GUI and at shutdown
+    pipeline.addTransform([&flightSummary](std::vector<PipelineSample>& batch) {
+        flightSummary.process(batch.data(), batch.size());
+    });
+    pipeline.addSink(logger);
+    if (binaryLogger) pipeline.addSink(*binaryLogger);
+    if (publisher) pipeline.addSink(*publisher);
+    if (blackBox) pipeline.addSink(*blackBox);
+    if (!config.headless) pipeline.addSink(gui);
+    gui.setPipeline(&pipeline);
+    gui.setClock(clock.get());
+    if (udpSource) gui.setStreamMonitor(&streamMonitor);
+    gui.setFlightSummary(&flightSummary);
+
+    // Source: gets data from flightgear or random gen
+    SensorReader reader(pipeline.input(), config, running, *clock, udpSource ? &streamMonitor : nullptr);
+
+    // Optional memory locking and placement of the render (main) thread
+    if (config.lockMemoryMB > 0) ThreadControl::lockMemory(config.lockMemoryMB);
+    ThreadControl::applyToCurrentThread(ThreadRole::GUI, config.threads[(int)ThreadRole::GUI]);
+
+    // Start the analyze and sink threads, then the source thread. In reactor mode the
+    // source thread runs the whole graph itself
+    if (!config.reactor) pipeline.start();
+    std::thread sensorThread([&reader, &config, &pipeline] {
+        ThreadControl::applyToCurrentThread(ThreadRole::Ingest, config.threads[(int)ThreadRole::Ingest]);
+        if (config.reactor) reader.runFGReactor(pipeline);
+        else reader.generateData();
+    });
+
+    // Render gui, only when new data, input or an alert change arrives. Headless runs
+    // until the source stops by itself (--duration) or Ctrl+C
+    if (config.headless) {
+        sensorThread.join();
+    } else {
+        while(!glfwWindowShouldClose(gui.window) && running){
+            if (gui.waitForFrame()) gui.render();
+        }
+    }
+
+    // Window closed, stop the pipeline threads
+    running = false;
 
-    sensorThread.join();
-    analyzerThread.join();
+    // Stop the source first, then drain the graph so every ingested sample is logged
+    if (sensorThread.joinable()) sensorThread.join();
+    pipeline.stop();
+    flightSummary.writeReport("data");
+    ThreadControl::printJitterReport();
+    ThreadControl::restoreProcess();
     
     //Shutdown gui
-    gui.shutdown();
+    if (!config.headless) gui.shutdown();
 
     return 0;
 }
\ No newline at end of file
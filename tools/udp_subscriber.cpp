@@ -0,0 +1,159 @@
+// Minimal subscriber for the pipeline's UDP rebroadcast (--publish), used to check the
+// stream's rate and loss. Build with "make subscriber" and run, e.g. over loopback:
+//   udp_subscriber 239.255.0.172:6000 30
+// Prints one line per second and a summary. Exit code is 1 if any datagram was lost.
+#include "../src/PublishFormat.hpp"
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+using Clock = std::chrono::steady_clock;
+
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        std::fprintf(stderr, "Usage: %s <address>:<port> [seconds]\n", argv[0]);
+        return 2;
+    }
+    std::string target = argv[1];
+    std::size_t colon = target.rfind(':');
+    if (colon == std::string::npos) {
+        std::fprintf(stderr, "Expected <address>:<port>, got %s\n", argv[1]);
+        return 2;
+    }
+    const std::string address = target.substr(0, colon);
+    const int port = std::atoi(target.c_str() + colon + 1);
+    const double duration = argc > 2 ? std::atof(argv[2]) : 0.0; // 0 = until Ctrl+C
+
+    WSADATA wsaData;
+    if (WSAStartup(MAKEWORD(2,2), &wsaData) != 0) {
+        std::fprintf(stderr, "WSAStartup failed\n");
+        return 2;
+    }
+
+    in_addr group{};
+    if (inet_pton(AF_INET, address.c_str(), &group) != 1) {
+        std::fprintf(stderr, "Invalid address: %s\n", address.c_str());
+        WSACleanup();
+        return 2;
+    }
+
+    SOCKET udpSocket = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+    if (udpSocket == INVALID_SOCKET) {
+        std::fprintf(stderr, "Socket creation failed\n");
+        WSACleanup();
+        return 2;
+    }
+
+    // Several subscribers may share the port on one host
+    BOOL reuse = TRUE;
+    setsockopt(udpSocket, SOL_SOCKET, SO_REUSEADDR, (const char*)&reuse, sizeof(reuse));
+    int recvBuffer = 1024 * 1024;
+    setsockopt(udpSocket, SOL_SOCKET, SO_RCVBUF, (const char*)&recvBuffer, sizeof(recvBuffer));
+    DWORD timeoutMs = 200; // Wake up to print even when nothing arrives
+    setsockopt(udpSocket, SOL_SOCKET, SO_RCVTIMEO, (const char*)&timeoutMs, sizeof(timeoutMs));
+
+    sockaddr_in local{};
+    local.sin_family = AF_INET;
+    local.sin_port = htons(port);
+    local.sin_addr.s_addr = INADDR_ANY;
+    if (bind(udpSocket, (SOCKADDR*)&local, sizeof(local)) == SOCKET_ERROR) {
+        std::fprintf(stderr, "Bind to port %d failed\n", port);
+        closesocket(udpSocket);
+        WSACleanup();
+        return 2;
+    }
+
+    const unsigned char firstOctet = reinterpret_cast<const unsigned char*>(&group)[0];
+    if (firstOctet >= 224 && firstOctet <= 239) {
+        ip_mreq membership{};
+        membership.imr_multiaddr = group;
+        membership.imr_interface.s_addr = INADDR_ANY;
+        if (setsockopt(udpSocket, IPPROTO_IP, IP_ADD_MEMBERSHIP, (const char*)&membership, sizeof(membership)) == SOCKET_ERROR) {
+            std::fprintf(stderr, "Joining group %s failed\n", address.c_str());
+            closesocket(udpSocket);
+            WSACleanup();
+            return 2;
+        }
+    }
+    std::printf("Listening on %s:%d\n", address.c_str(), port);
+
+    // Totals and the per second window
+    uint64_t datagrams = 0, records = 0, lostDatagrams = 0, skippedSamples = 0, malformed = 0;
+    uint64_t reorderedDatagrams = 0, reorderedSamples = 0;
+    uint64_t windowDatagrams = 0, windowRecords = 0;
+    uint32_t expectedSequence = 0;
+    uint32_t lastSampleSeq = 0;
+    bool started = false, sampleStarted = false;
+
+    alignas(8) char buffer[PUBLISH_MAX_DATAGRAM + 64];
+    const Clock::time_point startTime = Clock::now();
+    Clock::time_point windowStart = startTime;
+
+    for (;;) {
+        int bytes = recv(udpSocket, buffer, sizeof(buffer), 0);
+        if (bytes != SOCKET_ERROR) {
+            PublishHeader header{};
+            if (bytes >= (int)sizeof(header)) std::memcpy(&header, buffer, sizeof(header));
+            if (header.magic != PUBLISH_MAGIC || header.version != PUBLISH_VERSION ||
+                bytes != (int)(sizeof(header) + header.count * sizeof(PackedSample))) {
+                ++malformed;
+            } else {
+                // Datagram gaps are network loss, sample gaps include drops inside the pipeline.
+                // The signed difference handles wrap-around; anything behind the newest number
+                // seen arrived late and is counted as reordered, so the counters never go back
+                const int32_t gap = started ? static_cast<int32_t>(header.sequence - expectedSequence) : 0;
+                if (gap < 0) ++reorderedDatagrams;
+                else {
+                    lostDatagrams += gap;
+                    expectedSequence = header.sequence + 1;
+                }
+                started = true;
+
+                const PackedSample* samples = reinterpret_cast<const PackedSample*>(buffer + sizeof(header));
+                for (uint16_t i = 0; i < header.count; ++i) {
+                    const int32_t skip = sampleStarted ? static_cast<int32_t>(samples[i].seq - lastSampleSeq - 1) : 0;
+                    if (skip < 0) ++reorderedSamples;
+                    else {
+                        skippedSamples += skip;
+                        lastSampleSeq = samples[i].seq;
+                    }
+                    sampleStarted = true;
+                }
+                ++datagrams;
+                ++windowDatagrams;
+                records += header.count;
+                windowRecords += header.count;
+            }
+        }
+
+        const Clock::time_point now = Clock::now();
+        const double window = std::chrono::duration<double>(now - windowStart).count();
+        if (window >= 1.0) {
+            std::printf("%8.1f samples/s %7.1f datagrams/s | lost datagrams %llu, skipped samples %llu, reordered %llu, malformed %llu\n",
+                        windowRecords / window, windowDatagrams / window, (unsigned long long)lostDatagrams,
+                        (unsigned long long)skippedSamples, (unsigned long long)reorderedDatagrams, (unsigned long long)malformed);
+            std::fflush(stdout);
+            windowStart = now;
+            windowDatagrams = windowRecords = 0;
+        }
+        if (duration > 0.0 && std::chrono::duration<double>(now - startTime).count() >= duration) break;
+    }
+
+    const double elapsed = std::chrono::duration<double>(Clock::now() - startTime).count();
+    std::printf("Received %llu samples in %llu datagrams over %.1f s (%.1f samples/s)\n",
+                (unsigned long long)records, (unsigned long long)datagrams, elapsed, records / elapsed);
+    std::printf("Lost datagrams %llu (%.3f%%), skipped samples %llu, malformed %llu\n",
+                (unsigned long long)lostDatagrams,
+                datagrams + lostDatagrams ? 100.0 * lostDatagrams / (datagrams + lostDatagrams) : 0.0,
+                (unsigned long long)skippedSamples, (unsigned long long)malformed);
+    std::printf("Reordered datagrams %llu, reordered samples %llu (counted as lost when their gap was seen)\n",
+                (unsigned long long)reorderedDatagrams, (unsigned long long)reorderedSamples);
+
+    closesocket(udpSocket);
+    WSACleanup();
+    return lostDatagrams == 0 ? 0 : 1;
+}